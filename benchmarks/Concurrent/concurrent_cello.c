@@ -0,0 +1,86 @@
+#include "Cello.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+** Usage: concurrent_cello <threads> <write percent> [mutex]
+**
+** Each thread runs OPS random lookups and inserts over KEYS keys. With
+** "mutex" a plain Table behind a single Mutex is used instead of a
+** ConcurrentTable, for comparison.
+*/
+
+enum {
+	KEYS = 100000,
+	OPS = 2000000
+};
+
+static var table = NULL;
+static var mutex = NULL;
+static int writes = 10;
+static int64_t sink = 0;
+
+static var worker(var args) {
+	uint64_t x = (uint64_t)c_int(get(args, $I(0))) * 0x9E3779B97F4A7C15ull + 1;
+	int64_t total = 0;
+	var key = $I(0);
+	var val = $I(0);
+	for (int i = 0; i < OPS; i++) {
+		x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+		((struct Int*)key)->val = (int64_t)((x >> 8) % KEYS);
+		((struct Int*)val)->val = i;
+		bool write = (int)(x % 100) < writes;
+		if (mutex isnt NULL) { lock(mutex); }
+		if (write) {
+			set(table, key, val);
+		} else {
+			var curr = try_get(table, key);
+			if (curr isnt NULL) { total += c_int(curr); }
+		}
+		if (mutex isnt NULL) { unlock(mutex); }
+	}
+	__atomic_fetch_add(&sink, total, __ATOMIC_RELAXED);
+	return NULL;
+}
+
+int main(int argc, char *argv[]) {
+
+	int nthreads = argc > 1 ? atoi(argv[1]) : 1;
+	writes = argc > 2 ? atoi(argv[2]) : 10;
+
+	if (argc > 3 and strcmp(argv[3], "mutex") is 0) {
+		table = new_root(Table, Int, Int);
+		mutex = new_root(Mutex);
+	} else {
+		table = new_root(ConcurrentTable, Int, Int);
+	}
+
+	for (int i = 0; i < KEYS; i++) { set(table, $I(i), $I(i)); }
+
+	var func = $(Function, worker);
+	var threads = new(Array, Box);
+	var seeds = new(Array, Int);
+	for (int i = 0; i < nthreads; i++) { push(seeds, $I(i)); }
+
+	struct timespec t0, t1;
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+
+	for (int i = 0; i < nthreads; i++) {
+		var t = new(Thread, func);
+		push(threads, t);
+		call(t, get(seeds, $I(i)));
+	}
+
+	foreach (t in threads) { join(deref(t)); }
+
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	double secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+	printf("%.0f ops/s\n", (double)nthreads * OPS / secs);
+
+	del_root(table);
+	if (mutex isnt NULL) { del_root(mutex); }
+
+	return 0;
+}
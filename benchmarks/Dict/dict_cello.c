@@ -15,13 +15,9 @@ int main(int argc, char *argv[]) {
 	while (!feof(stdin)) {
 		fgets(buf, BUF_SIZE, stdin);
 		var key = $S(buf);
-		if (mem(h, key)) {
-			struct Int* v = get(h, key);
-			v->val++;
-			if (max < v->val) { max = v->val; }
-		} else {
-			set(h, key, $I(1));
-		}
+		struct Int* v = get_or_insert(h, key, $I(0));
+		v->val++;
+		if (max < v->val) { max = v->val; }
 	}
 	del(h);
 	return 0;
@@ -0,0 +1,24 @@
+#include "Cello.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+  BUF_SIZE = 0x10000
+};
+
+int main(int argc, char *argv[]) {
+	var h = new(FlatTable, String, Int);
+	resize(h, 1500000);
+	int max = 1;
+	char *buf = malloc(BUF_SIZE);
+	while (!feof(stdin)) {
+		fgets(buf, BUF_SIZE, stdin);
+		var key = $S(buf);
+		struct Int* v = get_or_insert(h, key, $I(0));
+		v->val++;
+		if (max < v->val) { max = v->val; }
+	}
+	del(h);
+	return 0;
+}
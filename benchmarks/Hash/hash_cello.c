@@ -0,0 +1,60 @@
+#include "Cello.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+** Usage: hash_cello
+**
+** For each key length hashes KEYS different keys over and over, printing
+** the throughput and time per hash. The "independent" rows hash keys whose
+** addresses are known up front, the "dependent" rows pick each key from
+** the previous hash, as a Table lookup chain would.
+*/
+
+enum {
+	KEYS = 1 << 16,
+	BYTES = 400000000
+};
+
+static double seconds(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+
+	size_t sizes[] = { 4, 8, 12, 16, 32, 64, 256 };
+	char* data = malloc(KEYS * 256);
+	for (size_t i = 0; i < KEYS * 256; i++) { data[i] = (char)rand(); }
+
+	uint64_t sink = 0;
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(size_t); s++) {
+
+		size_t n = sizes[s];
+		size_t total = BYTES / n;
+
+		double t0 = seconds();
+		for (size_t i = 0; i < total; i++) {
+			sink += hash_data(data + (i % KEYS) * n, n);
+		}
+		double t1 = seconds();
+
+		uint64_t h = 0;
+		for (size_t i = 0; i < total; i++) {
+			h = hash_data(data + (h % KEYS) * n, n);
+		}
+		double t2 = seconds();
+		sink += h;
+
+		printf("%3zu bytes independent: %5.2f GB/s %5.2f ns/hash\n",
+			n, BYTES / (t1 - t0) / 1e9, (t1 - t0) / total * 1e9);
+		printf("%3zu bytes dependent:   %5.2f GB/s %5.2f ns/hash\n",
+			n, BYTES / (t2 - t1) / 1e9, (t2 - t1) / total * 1e9);
+	}
+
+	free(data);
+	return sink is 0;
+}
@@ -0,0 +1,25 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <setjmp.h>
+
+static jmp_buf* handler = NULL;
+
+int main(int argc, char** argv) {
+  
+  volatile int64_t total = 0;
+  
+  for (int64_t i = 0; i < 50000000; i++) {
+    jmp_buf env;
+    jmp_buf* prev = handler;
+    handler = &env;
+    if (!setjmp(env)) {
+      total += i;
+    } else {
+      total -= 1;
+    }
+    handler = prev;
+  }
+  
+  printf("%lli\n", (long long)total);
+  
+}
@@ -0,0 +1,17 @@
+#include "Cello.h"
+
+int main(int argc, char** argv) {
+  
+  volatile int64_t total = 0;
+  
+  for (int64_t i = 0; i < 50000000; i++) {
+    try {
+      total += i;
+    } catch (e in KeyError) {
+      total -= 1;
+    }
+  }
+  
+  printf("%lli\n", (long long)total);
+  
+}
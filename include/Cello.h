@@ -62,6 +62,12 @@
 #define CELLO_MAGIC_HEADER
 #endif
 
+#ifdef CELLO_RC
+#define CELLO_RC_HEADER NULL,
+#else
+#define CELLO_RC_HEADER
+#endif
+
 #ifndef CELLO_CACHE
 #define CELLO_CACHE 1
 #define CELLO_CACHE_HEADER \
@@ -99,6 +105,26 @@
 #endif
 #endif
 
+#ifndef CELLO_THREAD_LOCAL
+#ifdef CELLO_MSC
+#define CELLO_THREAD_LOCAL __declspec(thread)
+#else
+#define CELLO_THREAD_LOCAL __thread
+#endif
+#endif
+
+/* C11 acquire/release ordering via builtins, so it also works in C99 */
+/* MSVC volatile accesses already have these semantics */
+#ifndef CELLO_LOAD_ACQUIRE
+#ifdef CELLO_MSC
+#define CELLO_LOAD_ACQUIRE(x) (x)
+#define CELLO_STORE_RELEASE(x, v) ((x) = (v))
+#else
+#define CELLO_LOAD_ACQUIRE(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define CELLO_STORE_RELEASE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#endif
+#endif
+
 /* Includes */
 
 #include <stdio.h>
@@ -128,6 +154,14 @@
 #endif
 #endif
 
+#ifdef CELLO_UNIX
+#define CELLO_SETJMP(env) _setjmp(env)
+#define CELLO_LONGJMP(env, val) _longjmp(env, val)
+#else
+#define CELLO_SETJMP(env) setjmp(env)
+#define CELLO_LONGJMP(env, val) longjmp(env, val)
+#endif
+
 /* Syntax */
 
 typedef void* var;
@@ -147,6 +181,7 @@ typedef void* var;
 #define CelloObject(T, S, ...) (var)((char*)((var[]){ NULL, \
   CELLO_ALLOC_HEADER       \
   CELLO_MAGIC_HEADER       \
+  CELLO_RC_HEADER          \
   CELLO_CACHE_HEADER       \
   NULL, "__Name",     #T,  \
   NULL, "__Size", (var)S,  \
@@ -163,17 +198,25 @@ extern var Tuple;
 
 extern var Ref;
 extern var Box;
+extern var WeakRef;
 extern var Int;
 extern var Float;
 extern var String;
+extern var Symbol;
 
 extern var Tree;
 extern var List;
 extern var Array;
 extern var Table;
+extern var FlatTable;
+extern var OrderedTable;
+extern var FrozenTable;
+extern var ConcurrentTable;
+extern var WeakTable;
 extern var Range;
 extern var Slice;
 extern var Zip;
+extern var Items;
 extern var Filter;
 extern var Map;
 extern var Terminal;
@@ -219,6 +262,9 @@ struct Header {
 #if CELLO_MAGIC_CHECK == 1
   var magic;
 #endif
+#ifdef CELLO_RC
+  intptr_t refs;
+#endif
 };
 
 struct Type {
@@ -235,6 +281,10 @@ struct Box {
   var val;
 };
 
+struct WeakRef {
+  var val;
+};
+
 struct Int {
   int64_t val;
 };
@@ -247,8 +297,14 @@ struct String {
   char* val;
 };
 
+struct Symbol {
+  char* val;
+  uint64_t hash;
+};
+
 struct Tuple {
   var* items;
+  uint64_t hash;
 };
 
 struct Range {
@@ -268,6 +324,11 @@ struct Zip {
   var values;
 };
 
+struct Items {
+  var iter;
+  var pair;
+};
+
 struct Filter {
   var iter;
   var func;
@@ -323,6 +384,7 @@ extern var Current;
 extern var Start;
 extern var Lock;
 extern var Mark;
+extern var Finalize;
 
 /* Signatures */
 
@@ -411,6 +473,14 @@ struct Get {
   void (*rem)(var, var);
   var (*key_type)(var);
   var (*val_type)(var);
+  var (*try_get)(var, var);
+  var (*get_or_insert)(var, var, var);
+  var (*try_get_int)(var, int64_t);
+  var (*try_get_cstr)(var, const char*, size_t);
+  void (*set_int)(var, int64_t, var);
+  void (*set_cstr)(var, const char*, size_t, var);
+  void (*get_many)(var, var, var);
+  void (*mem_many)(var, var, var);
 };
 
 struct Iter {
@@ -419,6 +489,7 @@ struct Iter {
   var (*iter_last)(var);
   var (*iter_prev)(var, var);
   var (*iter_type)(var);  
+  var (*iter_val)(var, var);
 };
 
 struct Sort {
@@ -427,6 +498,9 @@ struct Sort {
 
 struct Resize {
   void (*resize)(var, size_t);
+  void (*reserve)(var, size_t);
+  void (*shrink_to_fit)(var);
+  void (*load_factors)(var, double, double);
 };
 
 struct C_Str {
@@ -492,6 +566,10 @@ struct Mark {
   void (*mark)(var, var, void(*)(var,void*));
 };
 
+struct Finalize {
+  bool (*local)(var);
+};
+
 /* Functions */
 
 const char* name(var type);
@@ -574,6 +652,9 @@ void del(var self);
 void del_raw(var self);
 void del_root(var self);
 
+var retain(var self);
+void release(var self);
+
 var assign(var self, var obj);
 var copy(var self);
 void swap(var self, var obj);
@@ -588,12 +669,16 @@ bool le(var self, var obj);
 
 uint64_t hash(var self);
 uint64_t hash_data(const void* data, size_t num);
+void hash_seed(uint64_t seed);
+uint64_t hash_combine(uint64_t h, uint64_t x);
+void hash_cache(var self);
 
 var iter_init(var self);
 var iter_next(var self, var curr);
 var iter_prev(var self, var curr);
 var iter_last(var self);
 var iter_type(var self);
+var iter_val(var self, var curr);
 
 #define foreach(...) foreach_xp(foreach_in, (__VA_ARGS__))
 #define foreach_xp(X, A) X A
@@ -602,7 +687,7 @@ var iter_type(var self);
   __Iter##X = instance(__##X, Iter), \
   X = ((struct Iter*)(__Iter##X))->iter_init(__##X); \
   X isnt Terminal; \
-  X = ((struct Iter*)(__Iter##X))->iter_next(__##X, X))
+  X = (gc_safepoint(), ((struct Iter*)(__Iter##X))->iter_next(__##X, X)))
 
 void push(var self, var obj);
 void pop(var self);
@@ -621,14 +706,37 @@ bool mem(var self, var key);
 void rem(var self, var key);
 var key_type(var self);
 var val_type(var self);
+var try_get(var self, var key);
+var get_or(var self, var key, var def);
+var get_or_insert(var self, var key, var def);
+var try_get_int(var self, int64_t key);
+var get_int(var self, int64_t key);
+bool mem_int(var self, int64_t key);
+void set_int(var self, int64_t key, var val);
+var try_get_cstr(var self, const char* key, size_t n);
+var get_cstr(var self, const char* key, size_t n);
+bool mem_cstr(var self, const char* key, size_t n);
+void set_cstr(var self, const char* key, size_t n, var val);
+void get_many(var self, var keys, var out);
+void mem_many(var self, var keys, var out);
+
+var table_from(var keys, var vals);
+var freeze(var self);
+void concurrent_update(var self, var key, var def, var f);
+void concurrent_compute(var self, var key, var f);
 
 void resize(var self, size_t n);
+void reserve(var self, size_t n);
+void shrink_to_fit(var self);
+void load_factors(var self, double min_load, double max_load);
 size_t len(var self);
 bool empty(var self);
 
 char* c_str(var self);
 int64_t c_int(var self);
 double c_float(var self);
+var intern(var self);
+bool Cello_Interned(void);
 
 #define range(...) range_stack($(Range, $I(0), 0, 0, 0), tuple(__VA_ARGS__))
 
@@ -646,11 +754,13 @@ double c_float(var self);
   $(Tuple, (var[(sizeof((var[]){__VA_ARGS__})/sizeof(var))+1]){0})))
 
 #define enumerate(I) enumerate_stack(zip(range(), I))
+#define items(I) items_stack($(Items, I, $(Tuple, (var[3]){0})))
 
 var range_stack(var self, var args);
 var slice_stack(var self, var args);
 var zip_stack(var self);
 var enumerate_stack(var self);
+var items_stack(var self);
 
 var sopen(var self, var resource, var options);
 void sclose(var self);
@@ -715,18 +825,18 @@ void lock(var self);
 bool trylock(var self);
 void unlock(var self);
 
-#define try { jmp_buf __env; exception_try(&__env); if (!setjmp(__env))
+#define try { jmp_buf __env; exception_try(&__env); if (!CELLO_SETJMP(__env))
 
 #define catch(...) catch_xp(catch_in, (__VA_ARGS__))
 #define catch_xp(X, A) X A
-#define catch_in(X, ...) else { exception_try_fail(); } exception_try_end(); } \
-  for (var X = exception_catch(tuple(__VA_ARGS__)); \
+#define catch_in(X, ...) else { exception_try_fail(); } } \
+  for (var X = exception_try_end() ? exception_catch(tuple(__VA_ARGS__)) : NULL; \
     X isnt NULL; X = NULL)
 
 #define throw(E, F, ...) exception_throw(E, F, tuple(__VA_ARGS__))
 
 void exception_try(jmp_buf* env);
-void exception_try_end(void);
+bool exception_try_end(void);
 void exception_try_fail(void);
 var exception_throw(var obj, const char* fmt, var args);
 var exception_catch(var args);
@@ -741,10 +851,30 @@ void mark(var self, var gc, void(*f)(var,void*));
 #ifndef CELLO_NGC
 
 extern var GC;
+extern var Root;
+
+struct Root {
+  var* ref;
+};
 
 int Cello_Main(int argc, char** argv);
 void Cello_Exit(void);
 
+void gc_finalize_async(var self, bool async);
+void gc_shared(var self, bool shared);
+void gc_root_push(var self, var* ref);
+void gc_root_pop(var self);
+void gc_stack_scan(var self, bool scan);
+void gc_safe_enter(void);
+void gc_safe_leave(void);
+
+extern volatile bool Cello_Safepoint;
+void Cello_Safepoint_Park(void);
+
+#define gc_safepoint() \
+  ((void)(CELLO_LOAD_ACQUIRE(Cello_Safepoint) \
+    ? (Cello_Safepoint_Park(), 0) : 0))
+
 #define main(...) \
   main(int argc, char** argv) { \
     var bottom = NULL; \
@@ -754,6 +884,12 @@ void Cello_Exit(void);
   }; \
   int Cello_Main(__VA_ARGS__)
 
+#else
+
+#define gc_safepoint() ((void)0)
+#define gc_safe_enter() ((void)0)
+#define gc_safe_leave() ((void)0)
+
 #endif
   
 #endif
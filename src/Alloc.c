@@ -18,6 +18,10 @@ var header_init(var head, var type, int alloc) {
   self->magic = (var)CELLO_MAGIC_NUM;
 #endif
 
+#ifdef CELLO_RC
+  self->refs = alloc is AllocHeap ? 1 : 0;
+#endif
+
   return ((char*)self) + sizeof(struct Header);
 }
 
@@ -42,6 +46,11 @@ static const char* Alloc_Description(void) {
     "\n\n"
     "Allocated memory is automatically registered with the garbage collector "
     "unless the functions `alloc_raw` and `dealloc_raw` are used."
+    "\n\n"
+    "When Cello is compiled with `CELLO_RC` every header also contains a "
+    "reference count. Heap allocations start with a count of one, while "
+    "objects on the stack, in the data segment, or stored inside collections "
+    "have a count of zero and are never counted."
   ;
 }
 
@@ -234,6 +243,20 @@ static const char* New_Description(void) {
     "The `new_raw` and `del_raw` functions can be called to construct and "
     "destruct objects without going via the Garbage Collector."
     "\n\n"
+    "When Cello is compiled with `CELLO_RC` all variations of `del` instead "
+    "release one reference to the object, and it is only destructed and "
+    "deallocated once the last reference is released. Because this happens "
+    "immediately the Garbage Collector is only required to reclaim cycles, "
+    "and can be stopped with `stop(current(GC))` for purely deterministic "
+    "memory management. Objects allocated while the Garbage Collector was "
+    "running are still reclaimed by it once their last reference is released."
+    "\n\n"
+    "Only a `Box` holds a counted reference. Other objects which store a "
+    "`var`, such as a `Tuple`, a `Ref`, or the fields of a user type, do not "
+    "retain it, so an object should only be released while it is no longer "
+    "reachable through them. Objects whose count never reaches zero in this "
+    "way are only reclaimed by the Garbage Collector."
+    "\n\n"
     "It is also possible to simply call the `construct` and `destruct` "
     "functions if you wish to construct an already allocated object."
     "\n\n"
@@ -293,6 +316,14 @@ static struct Method* New_Methods(void) {
       "Destruct the object `self` manually. If registered with the "
       "Garbage Collector then entry will be removed. If `del_raw` is used then"
       "the destruction will be done without going via the Garbage Collector."
+    }, {
+      "retain",
+      "var retain(var self);\n"
+      "void release(var self);",
+      "When compiled with `CELLO_RC` increment or decrement the reference "
+      "count of the heap object `self`, destructing and deallocating it when "
+      "the count reaches zero. Otherwise `retain` does nothing and `release` "
+      "leaves the object to the Garbage Collector."
     }, {
       "construct",
       "#define construct(self, ...)\n"
@@ -344,8 +375,68 @@ var new_root_with(var type, var args) {
   return construct_with(alloc_root(type), args);
 }
 
+#ifdef CELLO_RC
+
+static intptr_t Header_Refs_Add(struct Header* head, intptr_t n) {
+#if defined(CELLO_MSC) && defined(_WIN64)
+  return InterlockedExchangeAdd64((LONG64*)&head->refs, n) + n;
+#elif defined(CELLO_MSC)
+  return InterlockedExchangeAdd((LONG*)&head->refs, n) + n;
+#else
+  return __atomic_add_fetch(&head->refs, n, __ATOMIC_ACQ_REL);
+#endif
+}
+
+#endif
+
+var retain(var self) {
+#ifdef CELLO_RC
+  if (self is NULL) { return self; }
+  struct Header* head = header(self);
+  if (head->refs isnt 0) { Header_Refs_Add(head, 1); }
+#endif
+  return self;
+}
+
+static void release_by(var self, int method) {
+#ifdef CELLO_RC
+  
+  if (self is NULL) { return; }
+  
+  struct Header* head = header(self);
+  if (head->refs is 0) { return; }
+  if (Header_Refs_Add(head, -1) isnt 0) { return; }
+  
+  /* Keep the count non-zero so a destructor can't release it twice */
+  head->refs = 1;
+  
+  switch (method) {
+    case ALLOC_STANDARD:
+    case ALLOC_ROOT:
+#ifndef CELLO_NGC
+    if (mem(current(GC), self)) {
+      rem(current(GC), self);
+      return;
+    }
+#endif
+    break;
+    case ALLOC_RAW: break;
+  }
+  
+  dealloc(destruct(self));
+  
+#endif
+}
+
+void release(var self) { release_by(self, ALLOC_STANDARD); }
+
 static void del_by(var self, int method) {
   
+#ifdef CELLO_RC
+  release_by(self, method);
+  return;
+#endif
+  
   switch (method) {
     case ALLOC_STANDARD:
     case ALLOC_ROOT:
@@ -23,6 +23,13 @@ static const char* Array_Description(void) {
     "the sequence is fast, with memory movement required for elements in the "
     "middle of the sequence." 
     "\n\n"
+    "When full an Array grows so that it is left `max_load` full, and once "
+    "fewer than `min_load` of its slots are in use it shrinks back to that "
+    "load. These default to two thirds and one quarter and can be changed "
+    "with `load_factors`. A `min_load` of zero stops it ever shrinking "
+    "automatically, while `reserve` and `shrink_to_fit` manage its capacity "
+    "by hand."
+    "\n\n"
     "This is largely equivalent to the C++ construct "
     "[std::vector](http://www.cplusplus.com/reference/vector/vector/)";
 }
@@ -83,8 +90,13 @@ struct Array {
   size_t tsize;
   size_t nitems;
   size_t nslots;
+  double min_load;
+  double max_load;
 };
 
+static const double Array_Min_Load = 0.25;
+static const double Array_Max_Load = 2.0 / 3.0;
+
 static size_t Array_Step(struct Array* a) {
   return a->tsize + sizeof(struct Header);
 }
@@ -110,6 +122,8 @@ static void Array_New(var self, var args) {
   a->tsize  = Array_Size_Round(size(a->type));
   a->nitems = len(args)-1;
   a->nslots = a->nitems;
+  a->min_load = Array_Min_Load;
+  a->max_load = Array_Max_Load;
   
   if (a->nslots is 0) {
     a->data = NULL;
@@ -168,6 +182,13 @@ static void Array_Assign(var self, var obj) {
   a->nitems = 0;
   a->nslots = 0;
   
+  if (a->max_load is 0) {
+    struct Array* o = obj;
+    bool array = type_of(obj) is Array;
+    a->min_load = array ? o->min_load : Array_Min_Load;
+    a->max_load = array ? o->max_load : Array_Max_Load;
+  }
+  
   if (implements_method(obj, Len, len)
   and implements_method(obj, Get, get)) {
   
@@ -202,10 +223,15 @@ static void Array_Assign(var self, var obj) {
   
 }
 
+static size_t Array_Ideal_Size(struct Array* a) {
+  size_t n = (size_t)((double)a->nitems / a->max_load);
+  return n > a->nitems ? n : a->nitems + 1;
+}
+
 static void Array_Reserve_More(struct Array* a) {
   
   if (a->nitems > a->nslots) {
-    a->nslots = a->nitems + a->nitems / 2;
+    a->nslots = Array_Ideal_Size(a);
     a->data = realloc(a->data, Array_Step(a) * a->nslots);
 #if CELLO_MEMORY_CHECK == 1
     if (a->data is NULL) {
@@ -261,7 +287,7 @@ static uint64_t Array_Hash(var self) {
   uint64_t h = 0;
   
   for (size_t i = 0; i < a->nitems; i++) {
-    h ^= hash(Array_Item(a, i));
+    h = hash_combine(h, hash(Array_Item(a, i)));
   }
   
   return h;
@@ -283,8 +309,8 @@ static bool Array_Mem(var self, var obj) {
 }
 
 static void Array_Reserve_Less(struct Array* a) {
-  if (a->nslots > a->nitems + a->nitems / 2) {
-    a->nslots = a->nitems;
+  if ((double)a->nitems < a->min_load * (double)a->nslots) {
+    a->nslots = Array_Ideal_Size(a);
     a->data = realloc(a->data, Array_Step(a) * a->nslots);
   }
 }
@@ -389,6 +415,14 @@ static var Array_Get(var self, var key) {
   return Array_Item(a, i);
 }
 
+static var Array_Try_Get(var self, var key) {
+  struct Array* a = self;
+  int64_t i = c_int(key);
+  i = i < 0 ? a->nitems+i : i;
+  if (i < 0 or i >= (int64_t)a->nitems) { return NULL; }
+  return Array_Item(a, i);
+}
+
 static void Array_Set(var self, var key, var val) {
 
   struct Array* a = self;
@@ -506,6 +540,51 @@ static void Array_Resize(var self, size_t n) {
 
 }
 
+static void Array_Reserve(var self, size_t n) {
+  struct Array* a = self;
+  
+  if (n <= a->nslots) { return; }
+  
+  a->nslots = n;
+  a->data = realloc(a->data, Array_Step(a) * a->nslots);
+  
+#if CELLO_MEMORY_CHECK == 1
+  if (a->data is NULL) {
+    throw(OutOfMemoryError, "Cannot grow Array, out of memory!");
+  }
+#endif
+  
+}
+
+static void Array_Shrink_To_Fit(var self) {
+  struct Array* a = self;
+  
+  if (a->nitems is a->nslots) { return; }
+  
+  if (a->nitems is 0) {
+    free(a->data);
+    a->data = NULL;
+    a->nslots = 0;
+    return;
+  }
+  
+  a->nslots = a->nitems;
+  a->data = realloc(a->data, Array_Step(a) * a->nslots);
+}
+
+static void Array_Load_Factors(var self, double min_load, double max_load) {
+  struct Array* a = self;
+  
+  if (max_load <= 0 or max_load >= 1 or min_load < 0 or min_load >= max_load) {
+    throw(ValueError,
+      "Invalid Array load factors %f and %f. Expected 0 < max < 1 "
+      "and 0 <= min < max.", $F(min_load), $F(max_load));
+  }
+  
+  a->min_load = min_load;
+  a->max_load = max_load;
+}
+
 static void Array_Mark(var self, var gc, void(*f)(var,void*)) {
   struct Array* a = self;
   for (size_t i = 0; i < a->nitems; i++) {
@@ -527,12 +606,15 @@ var Array = Cello(Array,
     Array_Push_At,  Array_Pop_At),
   Instance(Concat,  Array_Concat, Array_Push),
   Instance(Len,     Array_Len),
-  Instance(Get,     Array_Get, Array_Set, Array_Mem, Array_Rem),
+  Instance(Get,     
+    Array_Get, Array_Set, Array_Mem, Array_Rem, 
+    NULL, NULL, Array_Try_Get),
   Instance(Iter,   
     Array_Iter_Init, Array_Iter_Next, 
     Array_Iter_Last, Array_Iter_Prev, Array_Iter_Type),
   Instance(Sort,    Array_Sort_By),
   Instance(Show,    Array_Show, NULL),
-  Instance(Resize,  Array_Resize));
+  Instance(Resize,
+    Array_Resize, Array_Reserve, Array_Shrink_To_Fit, Array_Load_Factors));
 
   
@@ -0,0 +1,577 @@
+#include "Cello.h"
+
+static const char* ConcurrentTable_Name(void) {
+  return "ConcurrentTable";
+}
+
+static const char* ConcurrentTable_Brief(void) {
+  return "Hash table shared between Threads";
+}
+
+static const char* ConcurrentTable_Description(void) {
+  return
+    "The `ConcurrentTable` type is a hash table which can be used by many "
+    "`Thread`s at once without an external `Mutex`. It has the same `Get`, "
+    "`Len` and `Iter` interface as `Table`."
+    "\n\n"
+    "Keys are spread over a fixed number of _stripes_ by their hash, each of "
+    "which is a `Table` guarded by its own read-write lock. Lookups take a "
+    "shared lock, so readers never wait for each other, and writes only "
+    "exclude other users of the same stripe. Each stripe grows on its own, "
+    "so a resize only ever holds up the small fraction of keys in that "
+    "stripe while the rest of the table stays available."
+    "\n\n"
+    "Unlike other collections `get` and `try_get` return a snapshot: a new "
+    "copy of the value, made while its stripe is locked, rather than a "
+    "pointer into the table. Other threads can never change or free a value "
+    "once it has been returned, but changing it also has no effect on the "
+    "table. Without the Garbage Collector these copies must be deleted with "
+    "`del`."
+    "\n\n"
+    "For the same reason there is no `get_or_insert` which returns the stored "
+    "value for updating in place. Instead `concurrent_update` and "
+    "`concurrent_compute` run a function on the stored value while its "
+    "stripe is write locked, so read-modify-write updates are never lost to "
+    "another thread. These functions must not use the same table."
+    "\n\n"
+    "Iteration takes no locks and must not run alongside writers.";
+}
+
+static struct Example* ConcurrentTable_Examples(void) {
+  
+  static struct Example examples[] = {
+    {
+      "Usage",
+      "var hits = new(ConcurrentTable, String, Int);\n"
+      "\n"
+      "/* In any number of Threads */\n"
+      "set(hits, $S(\"/index.html\"), $I(1));\n"
+      "\n"
+      "if (mem(hits, $S(\"/index.html\"))) {\n"
+      "  print(\"Visited!\\n\");\n"
+      "}\n"
+      "\n"
+      "/* A copy, so safe while other Threads set the key */\n"
+      "show(get(hits, $S(\"/index.html\")));\n"
+    }, {
+      "Updating",
+      "static var count_hit(var args) {\n"
+      "  var hits = get(args, $I(0));\n"
+      "  assign(hits, $I(c_int(hits) + 1));\n"
+      "  return NULL;\n"
+      "}\n"
+      "\n"
+      "concurrent_update(hits, $S(\"/index.html\"), $I(0),\n"
+      "  $(Function, count_hit));\n"
+    }, {NULL, NULL}
+  };
+  
+  return examples;
+  
+}
+
+static struct Method* ConcurrentTable_Methods(void) {
+  
+  static struct Method methods[] = {
+    {
+      "concurrent_update",
+      "void concurrent_update(var self, var key, var def, var f);",
+      "Call `f` with the value stored at `key` in the `ConcurrentTable` "
+      "`self` while its stripe is write locked, so that `f` can change it in "
+      "place. If `key` is not in the table `def` is inserted first."
+    }, {
+      "concurrent_compute",
+      "void concurrent_compute(var self, var key, var f);",
+      "Call `f` with `key` and the value stored at `key`, or `NULL` if it is "
+      "missing, while its stripe is write locked. The object `f` returns is "
+      "copied in as the new value, so it must outlive `f`, such as one made "
+      "with `new`. If `f` returns `NULL` the key is removed."
+    }, {NULL, NULL, NULL}
+  };
+  
+  return methods;
+}
+
+struct ConcurrentTable_Stripe {
+#if defined(CELLO_UNIX)
+  pthread_rwlock_t lock;
+#elif defined(CELLO_WINDOWS)
+  SRWLOCK lock;
+#endif
+  var table;
+};
+
+struct ConcurrentTable {
+  var ktype;
+  var vtype;
+  var stripes;
+};
+
+/*
+**  Stripes are padded out to whole cache lines with one spare line between
+**  them, so threads working on neighbouring stripes never share a line even
+**  though `malloc` gives no cache line alignment.
+*/
+
+enum {
+  CONCURRENTTABLE_BITS   = 6,
+  CONCURRENTTABLE_NUM    = 1 << CONCURRENTTABLE_BITS,
+  CONCURRENTTABLE_LINE   = 64
+};
+
+static size_t ConcurrentTable_Step(void) {
+  size_t s = sizeof(struct ConcurrentTable_Stripe);
+  s = ((s + CONCURRENTTABLE_LINE - 1) / CONCURRENTTABLE_LINE);
+  return (s + 1) * CONCURRENTTABLE_LINE;
+}
+
+static struct ConcurrentTable_Stripe* ConcurrentTable_Stripe_At(
+  struct ConcurrentTable* c, size_t i) {
+  return (struct ConcurrentTable_Stripe*)
+    ((char*)c->stripes + i * ConcurrentTable_Step());
+}
+
+/*
+**  Each stripe's `Table` picks slots with the top bits of the hash times the
+**  golden ratio, so the stripe is picked with a different mix of the hash.
+**  Otherwise every key in a stripe would share the top bits of its slot.
+*/
+
+static struct ConcurrentTable_Stripe* ConcurrentTable_Stripe_Of(
+  struct ConcurrentTable* c, var key) {
+  uint64_t h = hash(key);
+  h = (h ^ (h >> 33)) * 0xFF51AFD7ED558CCDull;
+  return ConcurrentTable_Stripe_At(c, h >> (64 - CONCURRENTTABLE_BITS));
+}
+
+/*
+**  Values are copied out into an object allocated before the stripe is
+**  locked, so no allocation, and so no collection, happens with a lock held.
+**  The copy is only handed to the Garbage Collector once it holds a value.
+*/
+
+static var ConcurrentTable_Copy_Out(
+  struct ConcurrentTable_Stripe* s, var key, var out) {
+  var val = try_get(s->table, key);
+  if (val is NULL) { return NULL; }
+  return assign(out, val);
+}
+
+/*
+**  Locks are first tried without blocking. Only if that fails does the
+**  thread enter a GC safe region to wait, so a collection started by the
+**  lock's holder is never stalled waiting for this thread.
+**
+**  Each thread counts the stripe locks it holds. The functions given to
+**  `concurrent_update` and `concurrent_compute` run under a lock and may
+**  trigger a collection, which must then not wait on any stripe lock.
+*/
+
+static CELLO_THREAD_LOCAL size_t ConcurrentTable_Held = 0;
+
+static void ConcurrentTable_Read_Lock(struct ConcurrentTable_Stripe* s) {
+  ConcurrentTable_Held++;
+#if defined(CELLO_UNIX)
+  if (pthread_rwlock_tryrdlock(&s->lock) isnt 0) {
+    gc_safe_enter();
+    pthread_rwlock_rdlock(&s->lock);
+    gc_safe_leave();
+  }
+#elif defined(CELLO_WINDOWS)
+  if (not TryAcquireSRWLockShared(&s->lock)) {
+    gc_safe_enter();
+    AcquireSRWLockShared(&s->lock);
+    gc_safe_leave();
+  }
+#endif
+}
+
+static void ConcurrentTable_Read_Unlock(struct ConcurrentTable_Stripe* s) {
+#if defined(CELLO_UNIX)
+  pthread_rwlock_unlock(&s->lock);
+#elif defined(CELLO_WINDOWS)
+  ReleaseSRWLockShared(&s->lock);
+#endif
+  ConcurrentTable_Held--;
+}
+
+static void ConcurrentTable_Write_Lock(struct ConcurrentTable_Stripe* s) {
+  ConcurrentTable_Held++;
+#if defined(CELLO_UNIX)
+  if (pthread_rwlock_trywrlock(&s->lock) isnt 0) {
+    gc_safe_enter();
+    pthread_rwlock_wrlock(&s->lock);
+    gc_safe_leave();
+  }
+#elif defined(CELLO_WINDOWS)
+  if (not TryAcquireSRWLockExclusive(&s->lock)) {
+    gc_safe_enter();
+    AcquireSRWLockExclusive(&s->lock);
+    gc_safe_leave();
+  }
+#endif
+}
+
+static void ConcurrentTable_Write_Unlock(struct ConcurrentTable_Stripe* s) {
+#if defined(CELLO_UNIX)
+  pthread_rwlock_unlock(&s->lock);
+#elif defined(CELLO_WINDOWS)
+  ReleaseSRWLockExclusive(&s->lock);
+#endif
+  ConcurrentTable_Held--;
+}
+
+static void ConcurrentTable_Set(var self, var key, var val);
+
+static void ConcurrentTable_Alloc(struct ConcurrentTable* c) {
+  
+  c->stripes = malloc(CONCURRENTTABLE_NUM * ConcurrentTable_Step());
+  
+#if CELLO_MEMORY_CHECK == 1
+  if (c->stripes is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate ConcurrentTable, out of memory!");
+  }
+#endif
+  
+  for (size_t i = 0; i < CONCURRENTTABLE_NUM; i++) {
+    struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_At(c, i);
+#if defined(CELLO_UNIX)
+    pthread_rwlock_init(&s->lock, NULL);
+#elif defined(CELLO_WINDOWS)
+    InitializeSRWLock(&s->lock);
+#endif
+    s->table = new_raw(Table, c->ktype, c->vtype);
+  }
+  
+}
+
+static void ConcurrentTable_Free(struct ConcurrentTable* c) {
+  
+  if (c->stripes is NULL) { return; }
+  
+  for (size_t i = 0; i < CONCURRENTTABLE_NUM; i++) {
+    struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_At(c, i);
+#if defined(CELLO_UNIX)
+    pthread_rwlock_destroy(&s->lock);
+#endif
+    del_raw(s->table);
+  }
+  
+  free(c->stripes);
+  c->stripes = NULL;
+}
+
+static void ConcurrentTable_New(var self, var args) {
+  
+  struct ConcurrentTable* c = self;
+  c->ktype = cast(get(args, $I(0)), Type);
+  c->vtype = cast(get(args, $I(1)), Type);
+  
+  size_t nargs = len(args);
+  if (nargs % 2 isnt 0) {
+    throw(FormatError,
+      "Received non multiple of two argument count to "
+      "ConcurrentTable constructor.");
+  }
+  
+  ConcurrentTable_Alloc(c);
+  
+  for (size_t i = 0; i < (nargs-2)/2; i++) {
+    var key = get(args, $I(2+(i*2)+0));
+    var val = get(args, $I(2+(i*2)+1));
+    ConcurrentTable_Set(c, key, val);
+  }
+  
+}
+
+static void ConcurrentTable_Del(var self) {
+  ConcurrentTable_Free(self);
+}
+
+static void ConcurrentTable_Assign(var self, var obj) {
+  struct ConcurrentTable* c = self;
+  ConcurrentTable_Free(c);
+  
+  c->ktype = implements_method(obj, Get, key_type) ? key_type(obj) : Ref;
+  c->vtype = implements_method(obj, Get, val_type) ? val_type(obj) : Ref;
+  
+  ConcurrentTable_Alloc(c);
+  
+  foreach (key in obj) {
+    ConcurrentTable_Set(c, key, get(obj, key));
+  }
+  
+}
+
+static var ConcurrentTable_Key_Type(var self) {
+  struct ConcurrentTable* c = self;
+  return c->ktype;
+}
+
+static var ConcurrentTable_Val_Type(var self) {
+  struct ConcurrentTable* c = self;
+  return c->vtype;
+}
+
+static var ConcurrentTable_Try_Get(var self, var key) {
+  struct ConcurrentTable* c = self;
+  key = cast(key, c->ktype);
+  
+  struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_Of(c, key);
+  var out = alloc_raw(c->vtype);
+  
+  ConcurrentTable_Read_Lock(s);
+  var val = ConcurrentTable_Copy_Out(s, key, out);
+  ConcurrentTable_Read_Unlock(s);
+  
+  if (val is NULL) {
+    dealloc(out);
+    return NULL;
+  }
+  
+#ifndef CELLO_NGC
+  set(current(GC), out, $I(0));
+#endif
+  return out;
+}
+
+static var ConcurrentTable_Get(var self, var key) {
+  var val = ConcurrentTable_Try_Get(self, key);
+  if (val is NULL) {
+    return throw(KeyError, "Key %$ not in ConcurrentTable!", key);
+  }
+  return val;
+}
+
+static void ConcurrentTable_Set(var self, var key, var val) {
+  struct ConcurrentTable* c = self;
+  key = cast(key, c->ktype);
+  val = cast(val, c->vtype);
+  
+  struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_Of(c, key);
+  ConcurrentTable_Write_Lock(s);
+  set(s->table, key, val);
+  ConcurrentTable_Write_Unlock(s);
+}
+
+static bool ConcurrentTable_Mem(var self, var key) {
+  struct ConcurrentTable* c = self;
+  key = cast(key, c->ktype);
+  
+  struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_Of(c, key);
+  ConcurrentTable_Read_Lock(s);
+  bool found = mem(s->table, key);
+  ConcurrentTable_Read_Unlock(s);
+  
+  return found;
+}
+
+static void ConcurrentTable_Rem(var self, var key) {
+  struct ConcurrentTable* c = self;
+  key = cast(key, c->ktype);
+  
+  struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_Of(c, key);
+  ConcurrentTable_Write_Lock(s);
+  bool found = mem(s->table, key);
+  if (found) { rem(s->table, key); }
+  ConcurrentTable_Write_Unlock(s);
+  
+  if (not found) {
+    throw(KeyError, "Key %$ not in ConcurrentTable!", key);
+  }
+}
+
+static size_t ConcurrentTable_Len(var self) {
+  struct ConcurrentTable* c = self;
+  
+  size_t n = 0;
+  for (size_t i = 0; i < CONCURRENTTABLE_NUM; i++) {
+    struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_At(c, i);
+    ConcurrentTable_Read_Lock(s);
+    n += len(s->table);
+    ConcurrentTable_Read_Unlock(s);
+  }
+  
+  return n;
+}
+
+static var ConcurrentTable_Iter_From(struct ConcurrentTable* c, size_t i) {
+  for (; i < CONCURRENTTABLE_NUM; i++) {
+    var curr = iter_init(ConcurrentTable_Stripe_At(c, i)->table);
+    if (curr isnt Terminal) { return curr; }
+  }
+  return Terminal;
+}
+
+static var ConcurrentTable_Iter_Init(var self) {
+  return ConcurrentTable_Iter_From(self, 0);
+}
+
+static var ConcurrentTable_Iter_Next(var self, var curr) {
+  struct ConcurrentTable* c = self;
+  
+  struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_Of(c, curr);
+  curr = iter_next(s->table, curr);
+  if (curr isnt Terminal) { return curr; }
+  
+  size_t i = ((char*)s - (char*)c->stripes) / ConcurrentTable_Step();
+  return ConcurrentTable_Iter_From(c, i+1);
+}
+
+static var ConcurrentTable_Iter_Type(var self) {
+  struct ConcurrentTable* c = self;
+  return c->ktype;
+}
+
+static int ConcurrentTable_Show(var self, var output, int pos) {
+  struct ConcurrentTable* c = self;
+  
+  pos = print_to(output, pos, "<'ConcurrentTable' At 0x%p {", self);
+  
+  bool first = true;
+  for (size_t i = 0; i < CONCURRENTTABLE_NUM; i++) {
+    struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_At(c, i);
+    ConcurrentTable_Read_Lock(s);
+    foreach (key in s->table) {
+      if (not first) { pos = print_to(output, pos, ", "); }
+      pos = print_to(output, pos, "%$:%$", key, get(s->table, key));
+      first = false;
+    }
+    ConcurrentTable_Read_Unlock(s);
+  }
+  
+  return print_to(output, pos, "}>");
+}
+
+static void ConcurrentTable_Reserve(var self, size_t n) {
+  struct ConcurrentTable* c = self;
+  for (size_t i = 0; i < CONCURRENTTABLE_NUM; i++) {
+    struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_At(c, i);
+    ConcurrentTable_Write_Lock(s);
+    reserve(s->table, n / CONCURRENTTABLE_NUM + 1);
+    ConcurrentTable_Write_Unlock(s);
+  }
+}
+
+static void ConcurrentTable_Resize(var self, size_t n) {
+  struct ConcurrentTable* c = self;
+  
+  if (n isnt 0) {
+    ConcurrentTable_Reserve(c, n);
+    return;
+  }
+  
+  for (size_t i = 0; i < CONCURRENTTABLE_NUM; i++) {
+    struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_At(c, i);
+    ConcurrentTable_Write_Lock(s);
+    resize(s->table, 0);
+    ConcurrentTable_Write_Unlock(s);
+  }
+}
+
+static void ConcurrentTable_Shrink_To_Fit(var self) {
+  struct ConcurrentTable* c = self;
+  for (size_t i = 0; i < CONCURRENTTABLE_NUM; i++) {
+    struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_At(c, i);
+    ConcurrentTable_Write_Lock(s);
+    shrink_to_fit(s->table);
+    ConcurrentTable_Write_Unlock(s);
+  }
+}
+
+/*
+**  Without a shared heap other threads keep writing while this one marks,
+**  so each stripe is read locked. When the world is stopped every other
+**  thread is parked, maybe holding a lock, and the stripes are left alone.
+**  So are they when this thread already holds a stripe lock, because it is
+**  collecting from inside a `concurrent_update` function, as waiting could
+**  then deadlock with itself or with a thread waiting on its lock.
+*/
+
+static void ConcurrentTable_Mark(var self, var gc, void(*f)(var,void*)) {
+  struct ConcurrentTable* c = self;
+  if (c->stripes is NULL) { return; }
+  
+  bool locking = true;
+#ifndef CELLO_NGC
+  locking = not CELLO_LOAD_ACQUIRE(Cello_Safepoint);
+#endif
+  locking = locking and ConcurrentTable_Held is 0;
+  
+  for (size_t i = 0; i < CONCURRENTTABLE_NUM; i++) {
+    struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_At(c, i);
+    if (locking) { ConcurrentTable_Read_Lock(s); }
+    mark(s->table, gc, f);
+    if (locking) { ConcurrentTable_Read_Unlock(s); }
+  }
+  
+}
+
+var ConcurrentTable = Cello(ConcurrentTable,
+  Instance(Doc,
+    ConcurrentTable_Name, ConcurrentTable_Brief, ConcurrentTable_Description,
+    NULL,                 ConcurrentTable_Examples, ConcurrentTable_Methods),
+  Instance(New,      ConcurrentTable_New, ConcurrentTable_Del),
+  Instance(Assign,   ConcurrentTable_Assign),
+  Instance(Mark,     ConcurrentTable_Mark),
+  Instance(Len,      ConcurrentTable_Len),
+  Instance(Get,
+    ConcurrentTable_Get, ConcurrentTable_Set,
+    ConcurrentTable_Mem, ConcurrentTable_Rem,
+    ConcurrentTable_Key_Type, ConcurrentTable_Val_Type,
+    ConcurrentTable_Try_Get, NULL),
+  Instance(Iter,
+    ConcurrentTable_Iter_Init, ConcurrentTable_Iter_Next,
+    NULL, NULL, ConcurrentTable_Iter_Type),
+  Instance(Show,     ConcurrentTable_Show, NULL),
+  Instance(Resize,
+    ConcurrentTable_Resize, ConcurrentTable_Reserve,
+    ConcurrentTable_Shrink_To_Fit, NULL));
+
+/*
+**  Exceptions thrown by the function are caught to release the stripe lock
+**  and then thrown again with the same message.
+*/
+
+void concurrent_update(var self, var key, var def, var f) {
+  struct ConcurrentTable* c = cast(self, ConcurrentTable);
+  key = cast(key, c->ktype);
+  def = cast(def, c->vtype);
+  
+  struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_Of(c, key);
+  ConcurrentTable_Write_Lock(s);
+  
+  try {
+    call(f, get_or_insert(s->table, key, def));
+  } catch (e) {
+    var msg = exception_message();
+    ConcurrentTable_Write_Unlock(s);
+    throw(e, "%s", msg);
+  }
+  
+  ConcurrentTable_Write_Unlock(s);
+}
+
+void concurrent_compute(var self, var key, var f) {
+  struct ConcurrentTable* c = cast(self, ConcurrentTable);
+  key = cast(key, c->ktype);
+  
+  struct ConcurrentTable_Stripe* s = ConcurrentTable_Stripe_Of(c, key);
+  ConcurrentTable_Write_Lock(s);
+  
+  try {
+    var curr = try_get(s->table, key);
+    var val = call(f, key, curr);
+    if (val is NULL) {
+      if (curr isnt NULL) { rem(s->table, key); }
+    } else if (val isnt curr) {
+      set(s->table, key, cast(val, c->vtype));
+    }
+  } catch (e) {
+    var msg = exception_message();
+    ConcurrentTable_Write_Unlock(s);
+    throw(e, "%s", msg);
+  }
+  
+  ConcurrentTable_Write_Unlock(s);
+}
@@ -2,9 +2,12 @@
 
 #define EXCEPTION_TLS_KEY "__Exception"
 
+static CELLO_THREAD_LOCAL struct Exception* Exception_Local = NULL;
+
 enum {
   EXCEPTION_MAX_DEPTH  = 2048,
-  EXCEPTION_MAX_STRACE = 25
+  EXCEPTION_MAX_STRACE = 25,
+  EXCEPTION_MAX_ARGS   = 8
 };
 
 var TypeError = CelloEmpty(TypeError);
@@ -31,6 +34,9 @@ struct Exception {
   size_t   depth;
   bool     active;
   jmp_buf* buffers[EXCEPTION_MAX_DEPTH];  
+  const char* fmt;
+  var      args[EXCEPTION_MAX_ARGS+1];
+  var      copies[EXCEPTION_MAX_ARGS];
 };
 
 static const char* Exception_Name(void) {
@@ -54,6 +60,17 @@ static const char* Exception_Description(void) {
     "evaluated otherwise the internal state of the exception system can go out "
     "of sync. For this reason please never use `return` inside a `try` block. "
     "\n\n"
+    "Entering and leaving a `try` block which does not throw performs no "
+    "allocation, and on Unix systems it does not save or restore the signal "
+    "mask, making it cheap enough to use around frequent operations."
+    "\n\n"
+    "The message of a thrown exception is only formatted when it is asked for "
+    "using `exception_message`, when the exception is shown, or when it goes "
+    "uncaught. Until then the format string and arguments are kept, with any "
+    "`Int`, `Float` or `String` arguments copied, so throwing is cheap when "
+    "the message is never read. Messages with other kinds of argument are "
+    "formatted straight away."
+    "\n\n"
     "The `exception_signals` method can be used to register some exception to "
     "be thrown for any of the "
     "[standard C signals](https://en.wikipedia.org/wiki/C_signal_handling)."
@@ -125,18 +142,82 @@ static void Exception_New(var self, var args) {
   e->obj = NULL;
   e->msg = new_raw(String);
   memset(e->buffers, 0, sizeof(jmp_buf*) * EXCEPTION_MAX_DEPTH);
+  e->fmt = NULL;
+  e->args[0] = Terminal;
+  memset(e->copies, 0, sizeof(var) * EXCEPTION_MAX_ARGS);
   set(current(Thread), $S(EXCEPTION_TLS_KEY), self);
+  Exception_Local = self;
 }
 
 static void Exception_Del(var self) {
   struct Exception* e = self;
   del_raw(e->msg);
+  for (size_t i = 0; i < EXCEPTION_MAX_ARGS; i++) {
+    if (e->copies[i] isnt NULL) { del_raw(e->copies[i]); }
+  }
   rem(current(Thread), $S(EXCEPTION_TLS_KEY));
+  if (Exception_Local is self) { Exception_Local = NULL; }
+}
+
+static void Exception_Render(struct Exception* e) {
+  if (e->fmt is NULL) { return; }
+  const char* fmt = e->fmt;
+  e->fmt = NULL;
+  print_to_with(e->msg, 0, fmt, $(Tuple, e->args));
+  e->args[0] = Terminal;
+}
+
+static bool Exception_Capture(
+  struct Exception* e, const char* fmt, var args) {
+  
+  struct Tuple* t = args;
+  size_t i = 0;
+  
+  while (t->items[i] isnt Terminal) {
+    
+    if (i is EXCEPTION_MAX_ARGS) { return false; }
+    
+    var a = t->items[i];
+    var type = a is NULL ? NULL : type_of(a);
+    
+    if (type is Int or type is Float or type is String) {
+      if (e->copies[i] is NULL or type_of(e->copies[i]) isnt type) {
+        if (e->copies[i] isnt NULL) { del_raw(e->copies[i]); }
+        e->copies[i] = new_raw(type);
+      }
+      e->args[i] = assign(e->copies[i], a);
+      i++;
+      continue;
+    }
+    
+    if (a is NULL or type is Type) {
+      e->args[i] = a;
+      i++;
+      continue;
+    }
+    
+#if CELLO_ALLOC_CHECK == 1
+    if (header(a)->alloc is (var)AllocStatic) {
+      e->args[i] = a;
+      i++;
+      continue;
+    }
+#endif
+    
+    return false;
+  }
+  
+  e->args[i] = Terminal;
+  e->fmt = fmt;
+  return true;
 }
 
 static void Exception_Assign(var self, var obj) {
   struct Exception* e = self;
   struct Exception* o = cast(obj, Exception);
+  Exception_Render(o);
+  e->fmt = NULL;
+  e->args[0] = Terminal;
   e->obj = o->obj;
   assign(e->msg, o->msg);
   e->depth = o->depth;
@@ -145,10 +226,25 @@ static void Exception_Assign(var self, var obj) {
 }
 
 static var Exception_Current(void) {
+  if (Exception_Local isnt NULL) { return Exception_Local; }
   return get(current(Thread), $S(EXCEPTION_TLS_KEY));
 }
 
+static struct Exception* Exception_Self(void) {
+  if (Exception_Local isnt NULL) { return Exception_Local; }
+  return current(Exception);
+}
+
 static void Exception_Signal(int sig) {
+  
+  /* Unblock as the handler is left by longjmp */
+#if defined(CELLO_UNIX)
+  sigset_t set;
+  sigemptyset(&set);
+  sigaddset(&set, sig);
+  sigprocmask(SIG_UNBLOCK, &set, NULL);
+#endif
+  
   switch(sig) {
     case SIGABRT: throw(ProgramAbortedError, "Program Aborted");
     case SIGFPE:  throw(DivisionByZeroError, "Division by Zero");
@@ -317,6 +413,8 @@ static void Exception_Backtrace(void) {}
 
 static void Exception_Error(struct Exception* e)  {
   
+  Exception_Render(e);
+  
   print_to($(File, stderr), 0, "\n");
   print_to($(File, stderr), 0, "!!\t\n");
   print_to($(File, stderr), 0, "!!\tUncaught %$\n", e->obj);
@@ -332,6 +430,7 @@ static void Exception_Error(struct Exception* e)  {
 
 static int Exception_Show(var self, var out, int pos) {
   struct Exception* e = self;
+  Exception_Render(e);
   return print_to(out, pos, 
     "<'Exception' At 0x%p %$ - %$>", self, e->obj, e->msg);
 }
@@ -357,7 +456,7 @@ void exception_signals(void) {
 }
 
 void exception_try(jmp_buf* env) {
-  struct Exception* e = current(Exception);
+  struct Exception* e = Exception_Self();
   if (e->depth is EXCEPTION_MAX_DEPTH) {
     fprintf(stderr, "Cello Fatal Error: Exception Buffer Overflow!\n");
     abort();
@@ -369,13 +468,18 @@ void exception_try(jmp_buf* env) {
 
 var exception_throw(var obj, const char* fmt, var args) {
 
-  struct Exception* e = current(Exception);
+  struct Exception* e = Exception_Self();
   
   e->obj = obj;
-  print_to_with(e->msg, 0, fmt, args);
+  e->fmt = NULL;
+  
+  if (not Exception_Capture(e, fmt, args)) {
+    e->args[0] = Terminal;
+    print_to_with(e->msg, 0, fmt, args);
+  }
   
   if (Exception_Len(e) >= 1) {
-    longjmp(*Exception_Buffer(e), 1);
+    CELLO_LONGJMP(*Exception_Buffer(e), 1);
   } else {
     Exception_Error(e);
   }
@@ -386,7 +490,7 @@ var exception_throw(var obj, const char* fmt, var args) {
 
 var exception_catch(var args) {
   
-  struct Exception* e = current(Exception);
+  struct Exception* e = Exception_Self();
   
   if (not e->active) { return NULL; }
   
@@ -404,7 +508,7 @@ var exception_catch(var args) {
   
   /* No matches found. Propagate to outward block */
   if (e->depth >= 1) {
-    longjmp(*Exception_Buffer(e), 1);
+    CELLO_LONGJMP(*Exception_Buffer(e), 1);
   } else {
     Exception_Error(e);
   }
@@ -413,16 +517,28 @@ var exception_catch(var args) {
   
 }
 
-void exception_try_end(void) {
-  struct Exception* e = current(Exception);
+bool exception_try_end(void) {
+  struct Exception* e = Exception_Self();
   if (e->depth == 0) {
     fprintf(stderr, "Cello Fatal Error: Exception Buffer Underflow!\n");
     abort();
   }
   e->depth--;
+  return e->active;
 }
 
 void exception_try_fail(void) {
-  struct Exception* e = current(Exception);
+  struct Exception* e = Exception_Self();
   e->active = true;
 }
+
+var exception_object(void) {
+  struct Exception* e = Exception_Self();
+  return e->obj;
+}
+
+var exception_message(void) {
+  struct Exception* e = Exception_Self();
+  Exception_Render(e);
+  return e->msg;
+}
@@ -0,0 +1,689 @@
+#include "Cello.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CELLO_FLATTABLE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define CELLO_FLATTABLE_NEON
+#include <arm_neon.h>
+#endif
+
+static const char* FlatTable_Name(void) {
+  return "FlatTable";
+}
+
+static const char* FlatTable_Brief(void) {
+  return "Hash table with SIMD probing";
+}
+
+static const char* FlatTable_Description(void) {
+  return
+    "The `FlatTable` type is a hash table data structure that maps keys to "
+    "values. It has the same interface as `Table` and also requires `Hash` "
+    "and `Cmp` to be defined on the key type."
+    "\n\n"
+    "Alongside its slots it keeps an array of one byte control tags, each "
+    "either marking a slot as empty or deleted, or holding seven bits of the "
+    "hash of the key stored there. Lookups compare a group of sixteen tags "
+    "at once using SSE2 or NEON, where available, and only call `cmp` on "
+    "keys whose tag matches. Keys and values are stored in separate arrays "
+    "so that probing only touches key memory, and the full hash of each key "
+    "is kept in a third array so that rehashing never calls `hash` again."
+    "\n\n"
+    "Removing an item frees its slot straight away unless a lookup may have "
+    "probed past it, in which case it leaves a deleted marker behind which "
+    "is cleared the next time the table is rehashed. The table does not "
+    "shrink unless it is resized. Iteration order is unspecified."
+    "\n\n"
+    "This is largely equivalent to the C++ construct "
+    "[absl::flat_hash_map](https://abseil.io/docs/cpp/guides/container)";
+}
+
+static struct Example* FlatTable_Examples(void) {
+  
+  static struct Example examples[] = {
+    {
+      "Usage",
+      "var prices = new(FlatTable, String, Int);\n"
+      "set(prices, $S(\"Apple\"),  $I(12));\n"
+      "set(prices, $S(\"Banana\"), $I( 6));\n"
+      "set(prices, $S(\"Pear\"),   $I(55));\n"
+      "\n"
+      "foreach (key in prices) {\n"
+      "  var price = get(prices, key);\n"
+      "  println(\"Price of %$ is %$\", key, price);\n"
+      "}\n"
+    }, {NULL, NULL}
+  };
+  
+  return examples;
+  
+}
+
+struct FlatTable {
+  var ktype;
+  var vtype;
+  size_t ksize;
+  size_t vsize;
+  size_t nslots;
+  size_t nitems;
+  size_t ngrowth;
+  uint8_t* ctrl;
+  uint64_t* hashes;
+  var keys;
+  var vals;
+};
+
+enum {
+  FLATTABLE_GROUP   = 16,
+  FLATTABLE_EMPTY   = 0x80,
+  FLATTABLE_DELETED = 0xFE
+};
+
+static uint32_t FlatTable_Match(const uint8_t* g, uint8_t h2) {
+#if defined(CELLO_FLATTABLE_SSE2)
+  __m128i c = _mm_loadu_si128((const __m128i*)g);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8((char)h2)));
+#elif defined(CELLO_FLATTABLE_NEON)
+  static const uint8_t bits[16] = {
+    1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+  uint8x16_t m = vandq_u8(
+    vceqq_u8(vld1q_u8(g), vdupq_n_u8(h2)), vld1q_u8(bits));
+  return vaddv_u8(vget_low_u8(m)) | (vaddv_u8(vget_high_u8(m)) << 8);
+#else
+  uint32_t m = 0;
+  for (int i = 0; i < FLATTABLE_GROUP; i++) {
+    if (g[i] is h2) { m |= 1 << i; }
+  }
+  return m;
+#endif
+}
+
+static uint32_t FlatTable_Match_Empty(const uint8_t* g) {
+  return FlatTable_Match(g, FLATTABLE_EMPTY);
+}
+
+static uint32_t FlatTable_Match_Free(const uint8_t* g) {
+#if defined(CELLO_FLATTABLE_SSE2)
+  return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)g));
+#elif defined(CELLO_FLATTABLE_NEON)
+  static const uint8_t bits[16] = {
+    1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+  uint8x16_t m = vandq_u8(
+    vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(g)), vdupq_n_s8(0)),
+    vld1q_u8(bits));
+  return vaddv_u8(vget_low_u8(m)) | (vaddv_u8(vget_high_u8(m)) << 8);
+#else
+  uint32_t m = 0;
+  for (int i = 0; i < FLATTABLE_GROUP; i++) {
+    if (g[i] & 0x80) { m |= 1 << i; }
+  }
+  return m;
+#endif
+}
+
+static size_t FlatTable_Bit(uint32_t m) {
+#if defined(__GNUC__)
+  return __builtin_ctz(m);
+#else
+  size_t i = 0;
+  while (not (m & 1)) { m = m >> 1; i++; }
+  return i;
+#endif
+}
+
+static size_t FlatTable_Bit_Last(uint32_t m) {
+#if defined(__GNUC__)
+  return __builtin_clz(m) - (32 - FLATTABLE_GROUP);
+#else
+  size_t i = 0;
+  while (not (m & (1 << (FLATTABLE_GROUP-1)))) { m = m << 1; i++; }
+  return i;
+#endif
+}
+
+static uint64_t FlatTable_Hash_Of(var key) {
+  uint64_t h = hash(key);
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+static uint8_t FlatTable_Tag(uint64_t h) {
+  return (uint8_t)(h >> 57);
+}
+
+static size_t FlatTable_Size_Round(size_t s) {
+  return ((s + sizeof(var) - 1) / sizeof(var)) * sizeof(var);
+}
+
+static size_t FlatTable_Key_Step(struct FlatTable* t) {
+  return sizeof(struct Header) + t->ksize;
+}
+
+static size_t FlatTable_Val_Step(struct FlatTable* t) {
+  return sizeof(struct Header) + t->vsize;
+}
+
+static var FlatTable_Key(struct FlatTable* t, size_t i) {
+  return (char*)t->keys + i * FlatTable_Key_Step(t) + sizeof(struct Header);
+}
+
+static var FlatTable_Val(struct FlatTable* t, size_t i) {
+  return (char*)t->vals + i * FlatTable_Val_Step(t) + sizeof(struct Header);
+}
+
+static bool FlatTable_Full(struct FlatTable* t, size_t i) {
+  return (t->ctrl[i] & 0x80) is 0;
+}
+
+static size_t FlatTable_Capacity(size_t nslots) {
+  return nslots - nslots / 8;
+}
+
+static size_t FlatTable_Ideal_Size(size_t size) {
+  size_t n = FLATTABLE_GROUP;
+  while (FlatTable_Capacity(n) < size) { n = n * 2; }
+  return n;
+}
+
+static void FlatTable_Set_Ctrl(struct FlatTable* t, size_t i, uint8_t c) {
+  t->ctrl[i] = c;
+  if (i < FLATTABLE_GROUP) { t->ctrl[t->nslots + i] = c; }
+}
+
+static bool FlatTable_Find(struct FlatTable* t,
+  var key, uint64_t h, size_t* out) {
+  
+  size_t mask = t->nslots-1;
+  size_t pos = h & mask;
+  size_t step = 0;
+  uint8_t tag = FlatTable_Tag(h);
+  
+  while (true) {
+    
+    const uint8_t* g = t->ctrl + pos;
+    
+    uint32_t m = FlatTable_Match(g, tag);
+    while (m isnt 0) {
+      size_t i = (pos + FlatTable_Bit(m)) & mask;
+      if (eq(FlatTable_Key(t, i), key)) {
+        *out = i;
+        return true;
+      }
+      m = m & (m-1);
+    }
+    
+    if (FlatTable_Match_Empty(g) isnt 0) { return false; }
+    
+    step += FLATTABLE_GROUP;
+    pos = (pos + step) & mask;
+  }
+  
+  return false;
+}
+
+static size_t FlatTable_Find_Free(struct FlatTable* t, uint64_t h) {
+  
+  size_t mask = t->nslots-1;
+  size_t pos = h & mask;
+  size_t step = 0;
+  
+  while (true) {
+    uint32_t m = FlatTable_Match_Free(t->ctrl + pos);
+    if (m isnt 0) { return (pos + FlatTable_Bit(m)) & mask; }
+    step += FLATTABLE_GROUP;
+    pos = (pos + step) & mask;
+  }
+  
+  return 0;
+}
+
+static void FlatTable_Alloc(struct FlatTable* t, size_t nslots) {
+  
+  t->nslots = nslots;
+  t->ngrowth = FlatTable_Capacity(nslots) - t->nitems;
+  t->ctrl = malloc(nslots + FLATTABLE_GROUP);
+  t->hashes = malloc(nslots * sizeof(uint64_t));
+  t->keys = malloc(nslots * FlatTable_Key_Step(t));
+  t->vals = malloc(nslots * FlatTable_Val_Step(t));
+  
+#if CELLO_MEMORY_CHECK == 1
+  if (t->ctrl is NULL or t->hashes is NULL
+  or  t->keys is NULL or t->vals is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate FlatTable, out of memory!");
+  }
+#endif
+  
+  memset(t->ctrl, FLATTABLE_EMPTY, nslots + FLATTABLE_GROUP);
+}
+
+static void FlatTable_Free(struct FlatTable* t) {
+  free(t->ctrl);
+  free(t->hashes);
+  free(t->keys);
+  free(t->vals);
+  t->ctrl = NULL;
+  t->hashes = NULL;
+  t->keys = NULL;
+  t->vals = NULL;
+  t->nslots = 0;
+  t->ngrowth = 0;
+}
+
+/* Returns the old slots so they can be freed once the caller is done */
+static struct FlatTable FlatTable_Rehash_Keep(
+  struct FlatTable* t, size_t new_size) {
+  
+  struct FlatTable old = *t;
+  FlatTable_Alloc(t, new_size);
+  
+  for (size_t i = 0; i < old.nslots; i++) {
+    if (not FlatTable_Full(&old, i)) { continue; }
+    
+    uint64_t h = old.hashes[i];
+    size_t j = FlatTable_Find_Free(t, h);
+    FlatTable_Set_Ctrl(t, j, FlatTable_Tag(h));
+    t->hashes[j] = h;
+    
+    memcpy((char*)FlatTable_Key(t, j) - sizeof(struct Header),
+      (char*)FlatTable_Key(&old, i) - sizeof(struct Header),
+      FlatTable_Key_Step(t));
+    memcpy((char*)FlatTable_Val(t, j) - sizeof(struct Header),
+      (char*)FlatTable_Val(&old, i) - sizeof(struct Header),
+      FlatTable_Val_Step(t));
+  }
+  
+  return old;
+}
+
+static void FlatTable_Rehash(struct FlatTable* t, size_t new_size) {
+  struct FlatTable old = FlatTable_Rehash_Keep(t, new_size);
+  FlatTable_Free(&old);
+}
+
+static var FlatTable_Upsert(struct FlatTable* t,
+  var key, var val, bool* found) {
+  
+  uint64_t h = FlatTable_Hash_Of(key);
+  size_t i;
+  
+  if (t->nslots isnt 0 and FlatTable_Find(t, key, h, &i)) {
+    *found = true;
+    return FlatTable_Val(t, i);
+  }
+  
+  /* Old slots are kept until the insert as key or val may point into them */
+  struct FlatTable old = { 0 };
+  if (t->ngrowth is 0) {
+    old = FlatTable_Rehash_Keep(t, FlatTable_Ideal_Size(t->nitems+1));
+  }
+  
+  i = FlatTable_Find_Free(t, h);
+  if (t->ctrl[i] is FLATTABLE_EMPTY) { t->ngrowth--; }
+  FlatTable_Set_Ctrl(t, i, FlatTable_Tag(h));
+  t->hashes[i] = h;
+  
+  header_init((char*)FlatTable_Key(t, i) - sizeof(struct Header),
+    t->ktype, AllocData);
+  header_init((char*)FlatTable_Val(t, i) - sizeof(struct Header),
+    t->vtype, AllocData);
+  memset(FlatTable_Key(t, i), 0, t->ksize);
+  memset(FlatTable_Val(t, i), 0, t->vsize);
+  assign(FlatTable_Key(t, i), key);
+  assign(FlatTable_Val(t, i), val);
+  t->nitems++;
+  
+  FlatTable_Free(&old);
+  
+  *found = false;
+  return FlatTable_Val(t, i);
+}
+
+static void FlatTable_Set(var self, var key, var val) {
+  struct FlatTable* t = self;
+  key = cast(key, t->ktype);
+  val = cast(val, t->vtype);
+  
+  bool found;
+  var curr = FlatTable_Upsert(t, key, val, &found);
+  if (found) { assign(curr, val); }
+}
+
+static void FlatTable_Clear(struct FlatTable* t) {
+  
+  for (size_t i = 0; i < t->nslots; i++) {
+    if (FlatTable_Full(t, i)) {
+      destruct(FlatTable_Key(t, i));
+      destruct(FlatTable_Val(t, i));
+    }
+  }
+  
+  FlatTable_Free(t);
+  t->nitems = 0;
+}
+
+static void FlatTable_New(var self, var args) {
+  
+  struct FlatTable* t = self;
+  t->ktype = cast(get(args, $(Int, 0)), Type);
+  t->vtype = cast(get(args, $(Int, 1)), Type);
+  t->ksize = FlatTable_Size_Round(size(t->ktype));
+  t->vsize = FlatTable_Size_Round(size(t->vtype));
+  t->nitems = 0;
+  t->ctrl = NULL;
+  t->hashes = NULL;
+  t->keys = NULL;
+  t->vals = NULL;
+  t->nslots = 0;
+  t->ngrowth = 0;
+  
+  size_t nargs = len(args);
+  if (nargs % 2 isnt 0) {
+    throw(FormatError,
+      "Received non multiple of two argument count to FlatTable constructor.");
+  }
+  
+  if ((nargs-2)/2 > 0) {
+    FlatTable_Alloc(t, FlatTable_Ideal_Size((nargs-2)/2));
+  }
+  
+  for(size_t i = 0; i < (nargs-2)/2; i++) {
+    var key = get(args, $(Int, 2+(i*2)+0));
+    var val = get(args, $(Int, 2+(i*2)+1));
+    FlatTable_Set(t, key, val);
+  }
+  
+}
+
+static void FlatTable_Del(var self) {
+  FlatTable_Clear(self);
+}
+
+static var FlatTable_Key_Type(var self) {
+  struct FlatTable* t = self;
+  return t->ktype;
+}
+
+static var FlatTable_Val_Type(var self) {
+  struct FlatTable* t = self;
+  return t->vtype;
+}
+
+static void FlatTable_Assign(var self, var obj) {
+  struct FlatTable* t = self;
+  FlatTable_Clear(t);
+  
+  t->ktype = implements_method(obj, Get, key_type) ? key_type(obj) : Ref;
+  t->vtype = implements_method(obj, Get, val_type) ? val_type(obj) : Ref;
+  t->ksize = FlatTable_Size_Round(size(t->ktype));
+  t->vsize = FlatTable_Size_Round(size(t->vtype));
+  
+  size_t n = len(obj);
+  if (n > 0) { FlatTable_Alloc(t, FlatTable_Ideal_Size(n)); }
+  
+  foreach(key in obj) {
+    FlatTable_Set(t, key, get(obj, key));
+  }
+  
+}
+
+static var FlatTable_Try_Get(var self, var key) {
+  struct FlatTable* t = self;
+  
+  if (key >= t->keys and ((char*)key) <
+    ((char*)t->keys) + t->nslots * FlatTable_Key_Step(t)) {
+    return FlatTable_Val(t,
+      (((char*)key) - ((char*)t->keys)) / FlatTable_Key_Step(t));
+  }
+  
+  key = cast(key, t->ktype);
+  
+  if (t->nslots is 0) { return NULL; }
+  
+  size_t i;
+  if (not FlatTable_Find(t, key, FlatTable_Hash_Of(key), &i)) {
+    return NULL;
+  }
+  return FlatTable_Val(t, i);
+}
+
+static var FlatTable_Get(var self, var key) {
+  var val = FlatTable_Try_Get(self, key);
+  if (val is NULL) {
+    return throw(KeyError, "Key %$ not in FlatTable!", key);
+  }
+  return val;
+}
+
+static var FlatTable_Get_Or_Insert(var self, var key, var val) {
+  struct FlatTable* t = self;
+  bool found;
+  return FlatTable_Upsert(t,
+    cast(key, t->ktype), cast(val, t->vtype), &found);
+}
+
+static bool FlatTable_Mem(var self, var key) {
+  struct FlatTable* t = self;
+  key = cast(key, t->ktype);
+  
+  if (t->nslots is 0) { return false; }
+  
+  size_t i;
+  return FlatTable_Find(t, key, FlatTable_Hash_Of(key), &i);
+}
+
+/*
+**  A lookup only stops at a group of sixteen slots containing an empty one.
+**  If every run of sixteen slots covering `i` holds an empty slot then no
+**  lookup can have probed past `i`, and it can be made empty again rather
+**  than deleted. This counts the full or deleted slots running back from
+**  just before `i` and on from `i` itself.
+*/
+
+static bool FlatTable_Never_Full(struct FlatTable* t, size_t i) {
+  
+  size_t before = (i - FLATTABLE_GROUP) & (t->nslots-1);
+  uint32_t after_empty = FlatTable_Match_Empty(t->ctrl + i);
+  uint32_t before_empty = FlatTable_Match_Empty(t->ctrl + before);
+  
+  if (after_empty is 0 or before_empty is 0) { return false; }
+  
+  return FlatTable_Bit(after_empty)
+    + FlatTable_Bit_Last(before_empty) < FLATTABLE_GROUP;
+}
+
+static void FlatTable_Rem(var self, var key) {
+  struct FlatTable* t = self;
+  key = cast(key, t->ktype);
+  
+  size_t i;
+  if (t->nslots is 0
+  or  not FlatTable_Find(t, key, FlatTable_Hash_Of(key), &i)) {
+    throw(KeyError, "Key %$ not in FlatTable!", key);
+  }
+  
+  destruct(FlatTable_Key(t, i));
+  destruct(FlatTable_Val(t, i));
+  
+  if (FlatTable_Never_Full(t, i)) {
+    FlatTable_Set_Ctrl(t, i, FLATTABLE_EMPTY);
+    t->ngrowth++;
+  } else {
+    FlatTable_Set_Ctrl(t, i, FLATTABLE_DELETED);
+  }
+  
+  t->nitems--;
+}
+
+static size_t FlatTable_Len(var self) {
+  struct FlatTable* t = self;
+  return t->nitems;
+}
+
+static var FlatTable_Iter_From(struct FlatTable* t, size_t i) {
+  
+  while (i < t->nslots) {
+    uint32_t m = (~FlatTable_Match_Free(t->ctrl + i)) & 0xFFFF;
+    if (m isnt 0) {
+      size_t j = i + FlatTable_Bit(m);
+      return j < t->nslots ? FlatTable_Key(t, j) : Terminal;
+    }
+    i += FLATTABLE_GROUP;
+  }
+  
+  return Terminal;
+}
+
+static size_t FlatTable_Index(struct FlatTable* t, var curr) {
+  return ((char*)curr - sizeof(struct Header) - (char*)t->keys)
+    / FlatTable_Key_Step(t);
+}
+
+static var FlatTable_Iter_Init(var self) {
+  struct FlatTable* t = self;
+  if (t->nitems is 0) { return Terminal; }
+  return FlatTable_Iter_From(t, 0);
+}
+
+static var FlatTable_Iter_Next(var self, var curr) {
+  struct FlatTable* t = self;
+  return FlatTable_Iter_From(t, FlatTable_Index(t, curr) + 1);
+}
+
+static var FlatTable_Iter_Prev(var self, var curr) {
+  struct FlatTable* t = self;
+  
+  size_t i = FlatTable_Index(t, curr);
+  while (i > 0) {
+    i--;
+    if (FlatTable_Full(t, i)) { return FlatTable_Key(t, i); }
+  }
+  
+  return Terminal;
+}
+
+static var FlatTable_Iter_Last(var self) {
+  struct FlatTable* t = self;
+  if (t->nitems is 0) { return Terminal; }
+  return FlatTable_Iter_Prev(self, FlatTable_Key(t, t->nslots));
+}
+
+static var FlatTable_Iter_Type(var self) {
+  struct FlatTable* t = self;
+  return t->ktype;
+}
+
+static var FlatTable_Iter_Val(var self, var curr) {
+  struct FlatTable* t = self;
+  return FlatTable_Val(t, FlatTable_Index(t, curr));
+}
+
+static int FlatTable_Cmp(var self, var obj) {
+  
+  int c;
+  var item0 = FlatTable_Iter_Init(self);
+  var item1 = iter_init(obj);
+  
+  while (true) {
+    if (item0 is Terminal and item1 is Terminal) { return 0; }
+    if (item0 is Terminal) { return -1; }
+    if (item1 is Terminal) { return  1; }
+    c = cmp(item0, item1);
+    if (c < 0) { return -1; }
+    if (c > 0) { return  1; }
+    c = cmp(FlatTable_Iter_Val(self, item0), iter_val(obj, item1));
+    if (c < 0) { return -1; }
+    if (c > 0) { return  1; }
+    item0 = FlatTable_Iter_Next(self, item0);
+    item1 = iter_next(obj, item1);
+  }
+  
+  return 0;
+  
+}
+
+static uint64_t FlatTable_Hash(var self) {
+  struct FlatTable* t = self;
+  uint64_t h = 0;
+  
+  for (size_t i = 0; i < t->nslots; i++) {
+    if (FlatTable_Full(t, i)) {
+      h += hash_combine(hash(FlatTable_Key(t, i)), hash(FlatTable_Val(t, i)));
+    }
+  }
+  
+  return h;
+}
+
+static int FlatTable_Show(var self, var output, int pos) {
+  struct FlatTable* t = self;
+  
+  pos = print_to(output, pos, "<'FlatTable' At 0x%p {", self);
+    
+  size_t j = 0;
+  for (size_t i = 0; i < t->nslots; i++) {
+    if (FlatTable_Full(t, i)) {
+      pos = print_to(output, pos, "%$:%$",
+        FlatTable_Key(t, i), FlatTable_Val(t, i));
+      if (j < t->nitems-1) { pos = print_to(output, pos, ", "); }
+      j++;
+    }
+  }
+    
+  return print_to(output, pos, "}>");
+}
+
+static void FlatTable_Resize(var self, size_t n) {
+  struct FlatTable* t = self;
+  
+  if (n is 0) {
+    FlatTable_Clear(t);
+    return;
+  }
+  
+#if CELLO_BOUND_CHECK == 1
+  if (n < t->nitems) {
+    throw(FormatError,
+      "Cannot resize FlatTable to make it smaller than %li items",
+      $I(t->nitems));
+  }
+#endif
+  
+  FlatTable_Rehash(t, FlatTable_Ideal_Size(n));
+}
+
+static void FlatTable_Mark(var self, var gc, void(*f)(var,void*)) {
+  struct FlatTable* t = self;
+  for (size_t i = 0; i < t->nslots; i++) {
+    if (FlatTable_Full(t, i)) {
+      f(gc, FlatTable_Key(t, i));
+      f(gc, FlatTable_Val(t, i));
+    }
+  }
+}
+
+var FlatTable = Cello(FlatTable,
+  Instance(Doc,
+    FlatTable_Name, FlatTable_Brief,    FlatTable_Description,
+    NULL,           FlatTable_Examples, NULL),
+  Instance(New,      FlatTable_New, FlatTable_Del),
+  Instance(Assign,   FlatTable_Assign),
+  Instance(Mark,     FlatTable_Mark),
+  Instance(Cmp,      FlatTable_Cmp),
+  Instance(Hash,     FlatTable_Hash),
+  Instance(Len,      FlatTable_Len),
+  Instance(Get,
+    FlatTable_Get, FlatTable_Set, FlatTable_Mem, FlatTable_Rem,
+    FlatTable_Key_Type, FlatTable_Val_Type,
+    FlatTable_Try_Get, FlatTable_Get_Or_Insert),
+  Instance(Iter,
+    FlatTable_Iter_Init, FlatTable_Iter_Next,
+    FlatTable_Iter_Last, FlatTable_Iter_Prev, FlatTable_Iter_Type,
+    FlatTable_Iter_Val),
+  Instance(Show,     FlatTable_Show, NULL),
+  Instance(Resize,   FlatTable_Resize));
@@ -0,0 +1,618 @@
+#include "Cello.h"
+
+static const char* FrozenTable_Name(void) {
+  return "FrozenTable";
+}
+
+static const char* FrozenTable_Brief(void) {
+  return "Immutable perfect hash table";
+}
+
+static const char* FrozenTable_Description(void) {
+  return
+    "The `FrozenTable` type is a hash table which cannot be changed once it "
+    "has been built. It is made with `freeze` from any other table, or with "
+    "`new` from a list of keys and values, and has the same lookup interface "
+    "as `Table`. Calling `set` or `rem` on it throws a `ValueError`."
+    "\n\n"
+    "When it is built a minimal perfect hash is found for its keys in the "
+    "style of [PTHash](https://arxiv.org/abs/2104.10402). Keys are split into "
+    "small buckets by hash, and each bucket stores a _pilot_ value chosen so "
+    "that every key lands in its own slot. Slots are packed together with "
+    "no empty space, and a lookup reads one pilot and checks one slot, "
+    "without ever probing."
+    "\n\n"
+    "Because lookups never write to memory a `FrozenTable` can be shared by "
+    "any number of `Thread`s without locking. Building takes around `O(n log "
+    "n)` time, so it is best suited to reference data which is loaded once "
+    "and then looked up many times."
+    "\n\n"
+    "Keys whose hashes are identical cannot be separated by the perfect hash. "
+    "If two different keys hash to the same value only the first gets a "
+    "slot, and the rest are stored after all the slots. A lookup which finds "
+    "its hash but not its key in the slot also checks these, so such keys "
+    "still work, but each costs a short scan."
+    "\n\n"
+    "Like `Table` it implements `try_get_int` and `try_get_cstr`, and "
+    "`String` and `Int` keys are hashed and compared directly rather than "
+    "through `hash` and `eq`.";
+}
+
+static struct Example* FrozenTable_Examples(void) {
+  
+  static struct Example examples[] = {
+    {
+      "Usage",
+      "var codes = new(Table, String, Int);\n"
+      "set(codes, $S(\"GB\"), $I(44));\n"
+      "set(codes, $S(\"FR\"), $I(33));\n"
+      "set(codes, $S(\"DE\"), $I(49));\n"
+      "\n"
+      "var frozen = freeze(codes);\n"
+      "show(get(frozen, $S(\"FR\"))); /* 33 */\n"
+    }, {NULL, NULL}
+  };
+  
+  return examples;
+  
+}
+
+static struct Method* FrozenTable_Methods(void) {
+  
+  static struct Method methods[] = {
+    {
+      "freeze",
+      "var freeze(var self);",
+      "Build a new `FrozenTable` with the same keys and values as `self`."
+    }, {NULL, NULL, NULL}
+  };
+  
+  return methods;
+}
+
+struct FrozenTable {
+  var ktype;
+  var vtype;
+  size_t ksize;
+  size_t vsize;
+  size_t nitems;
+  size_t nslots;
+  size_t nbuckets;
+  uint32_t* pilots;
+  var entries;
+};
+
+enum {
+  FROZENTABLE_BUCKET_SIZE = 4
+};
+
+static size_t FrozenTable_Size_Round(size_t s) {
+  return ((s + sizeof(var) - 1) / sizeof(var)) * sizeof(var);
+}
+
+static size_t FrozenTable_Step(struct FrozenTable* t) {
+  return
+    sizeof(uint64_t) +
+    sizeof(struct Header) + t->ksize +
+    sizeof(struct Header) + t->vsize;
+}
+
+static char* FrozenTable_Entry(struct FrozenTable* t, size_t i) {
+  return (char*)t->entries + i * FrozenTable_Step(t);
+}
+
+static uint64_t FrozenTable_Entry_Hash(struct FrozenTable* t, size_t i) {
+  return *(uint64_t*)FrozenTable_Entry(t, i);
+}
+
+static var FrozenTable_Key(struct FrozenTable* t, size_t i) {
+  return FrozenTable_Entry(t, i) +
+    sizeof(uint64_t) +
+    sizeof(struct Header);
+}
+
+static var FrozenTable_Val(struct FrozenTable* t, size_t i) {
+  return FrozenTable_Entry(t, i) +
+    sizeof(uint64_t) +
+    sizeof(struct Header) +
+    t->ksize +
+    sizeof(struct Header);
+}
+
+/*
+**  Hashes such as those of `Int` are not well distributed, so they are
+**  mixed before use. The bucket comes from the top bits of the mixed hash
+**  and the slot from mixing it again with the bucket's pilot. Both map a
+**  32-bit value onto a range with a multiply rather than a division.
+*/
+
+static uint64_t FrozenTable_Mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDull;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+static size_t FrozenTable_Range(uint64_t x, size_t n) {
+  return (size_t)(((x >> 32) * (uint64_t)n) >> 32);
+}
+
+static size_t FrozenTable_Bucket(struct FrozenTable* t, uint64_t x) {
+  return FrozenTable_Range(x, t->nbuckets);
+}
+
+static size_t FrozenTable_Slot(size_t n, uint64_t x, uint32_t pilot) {
+  return FrozenTable_Range(
+    FrozenTable_Mix(x ^ (pilot * 0x9E3779B97F4A7C15ull)), n);
+}
+
+static void FrozenTable_Clear(struct FrozenTable* t) {
+  
+  for (size_t i = 0; i < t->nitems; i++) {
+    destruct(FrozenTable_Key(t, i));
+    destruct(FrozenTable_Val(t, i));
+  }
+  
+  free(t->pilots);
+  free(t->entries);
+  
+  t->nitems = 0;
+  t->nslots = 0;
+  t->nbuckets = 0;
+  t->pilots = NULL;
+  t->entries = NULL;
+}
+
+/*
+**  Buckets are placed largest first, since small buckets are the easiest
+**  to fit into the slots which are left. For each one the pilot is counted
+**  up from zero until all of its keys land in distinct free slots.
+**
+**  Keys with the same hash always share a bucket. All but the first are
+**  taken out of it before placing and given the entries at the very end,
+**  after the `nslots` entries reached by the perfect hash.
+**
+**  Everything is allocated before the first key is cast, hashed or
+**  assigned, and the scratch arrays share one block, so if any of those
+**  throw the handler can release it all before passing the exception on.
+*/
+
+static void FrozenTable_Build(struct FrozenTable* t, var obj) {
+  
+  size_t n = len(obj);
+  
+  if (n > UINT32_MAX) {
+    throw(ValueError, "Cannot freeze more than %li items", $I(UINT32_MAX));
+  }
+  
+  size_t nbuckets = n / FROZENTABLE_BUCKET_SIZE + 1;
+  
+  struct FrozenTable s = *t;
+  s.nitems = n;
+  s.nbuckets = nbuckets;
+  s.pilots = calloc(nbuckets, sizeof(uint32_t));
+  s.entries = calloc(1, n * FrozenTable_Step(&s) + 1);
+  
+  char* block = calloc(1,
+    sizeof(uint64_t) * 2 * n +
+    sizeof(var) * 2 * n +
+    sizeof(size_t) * (2 * n + 2 * nbuckets + 1) + n + 1);
+  
+#if CELLO_MEMORY_CHECK == 1
+  if (block is NULL or s.pilots is NULL or s.entries is NULL) {
+    free(block); free(s.pilots); free(s.entries);
+    throw(OutOfMemoryError, "Cannot allocate FrozenTable, out of memory!");
+  }
+#endif
+  
+  uint64_t* hashes = (uint64_t*)block;
+  uint64_t* mixed = hashes + n;
+  var* keys = (var*)(mixed + n);
+  var* vals = keys + n;
+  size_t* order = (size_t*)(vals + n);
+  size_t* starts = order + n;
+  size_t* sizes = starts + nbuckets + 1;
+  size_t* slots = sizes + nbuckets;
+  uint8_t* taken = (uint8_t*)(slots + n);
+  uint32_t* pilots = s.pilots;
+  
+  volatile size_t done = 0;
+  volatile bool keyed = false;
+  
+  try {
+    
+    size_t k = 0;
+    foreach (key in obj) {
+      keys[k] = cast(key, t->ktype);
+      vals[k] = cast(get(obj, key), t->vtype);
+      hashes[k] = hash(keys[k]);
+      mixed[k] = FrozenTable_Mix(hashes[k]);
+      k++;
+    }
+    
+    /* Group items by bucket with a counting sort */
+    
+    memset(starts, 0, sizeof(size_t) * (nbuckets + 1));
+    for (size_t i = 0; i < n; i++) {
+      starts[FrozenTable_Bucket(&s, mixed[i]) + 1]++;
+    }
+    
+    size_t largest = 0;
+    for (size_t b = 0; b < nbuckets; b++) {
+      sizes[b] = starts[b+1];
+      largest = sizes[b] > largest ? sizes[b] : largest;
+      starts[b+1] += starts[b];
+    }
+    
+    for (size_t i = 0; i < n; i++) {
+      size_t b = FrozenTable_Bucket(&s, mixed[i]);
+      order[starts[b] + sizes[b] - 1] = i;
+      sizes[b]--;
+    }
+    
+    /* Move keys with a repeated hash to the end of the entries */
+    
+    size_t nover = 0;
+    for (size_t b = 0; b < nbuckets; b++) {
+      
+      size_t* items = &order[starts[b]];
+      size_t kept = 0;
+      
+      for (size_t i = 0; i < starts[b+1] - starts[b]; i++) {
+        size_t j = 0;
+        while (j < kept and mixed[items[j]] isnt mixed[items[i]]) { j++; }
+        if (j < kept) {
+          slots[items[i]] = n - 1 - nover++;
+        } else {
+          items[kept++] = items[i];
+        }
+      }
+      
+      sizes[b] = kept;
+    }
+    
+    s.nslots = n - nover;
+    
+    /* Place buckets from largest to smallest */
+    
+    for (size_t m = largest; m > 0; m--) {
+      for (size_t b = 0; b < nbuckets; b++) {
+        
+        if (sizes[b] isnt m) { continue; }
+        size_t* items = &order[starts[b]];
+        
+        uint32_t pilot = 0;
+        while (true) {
+          
+          size_t i = 0;
+          for (; i < m; i++) {
+            size_t slot = FrozenTable_Slot(s.nslots, mixed[items[i]], pilot);
+            if (taken[slot]) { break; }
+            taken[slot] = 1;
+            slots[items[i]] = slot;
+          }
+          
+          if (i is m) { break; }
+          
+          for (size_t j = 0; j < i; j++) { taken[slots[items[j]]] = 0; }
+          pilot++;
+        }
+        
+        pilots[b] = pilot;
+      }
+    }
+    
+    /* Copy keys and values into their slots */
+    
+    for (size_t i = 0; i < n; i++) {
+      char* entry = FrozenTable_Entry(&s, slots[i]);
+      memcpy(entry, &hashes[i], sizeof(uint64_t));
+      header_init((struct Header*)(entry + sizeof(uint64_t)),
+        s.ktype, AllocData);
+      header_init((struct Header*)(entry + sizeof(uint64_t) +
+        sizeof(struct Header) + s.ksize), s.vtype, AllocData);
+      assign(FrozenTable_Key(&s, slots[i]), keys[i]);
+      keyed = true;
+      assign(FrozenTable_Val(&s, slots[i]), vals[i]);
+      keyed = false;
+      done++;
+    }
+    
+  } catch (e) {
+    
+    var msg = exception_message();
+    for (size_t i = 0; i < done; i++) {
+      destruct(FrozenTable_Key(&s, slots[i]));
+      destruct(FrozenTable_Val(&s, slots[i]));
+    }
+    if (keyed) { destruct(FrozenTable_Key(&s, slots[done])); }
+    
+    free(block); free(s.pilots); free(s.entries);
+    throw(e, "%s", msg);
+  }
+  
+  free(block);
+  
+  FrozenTable_Clear(t);
+  *t = s;
+}
+
+static void FrozenTable_New(var self, var args) {
+  
+  struct FrozenTable* t = self;
+  t->ktype = cast(get(args, $I(0)), Type);
+  t->vtype = cast(get(args, $I(1)), Type);
+  t->ksize = FrozenTable_Size_Round(size(t->ktype));
+  t->vsize = FrozenTable_Size_Round(size(t->vtype));
+  t->nitems = 0;
+  t->nslots = 0;
+  t->nbuckets = 0;
+  t->pilots = NULL;
+  t->entries = NULL;
+  
+  size_t nargs = len(args);
+  if (nargs % 2 isnt 0) {
+    throw(FormatError,
+      "Received non multiple of two argument count to "
+      "FrozenTable constructor.");
+  }
+  
+  if (nargs is 2) { return; }
+  
+  /* Build through a Table so that repeated keys keep their last value */
+  var pairs = new_raw(Table, t->ktype, t->vtype);
+  
+  try {
+    for (size_t i = 0; i < (nargs-2)/2; i++) {
+      set(pairs, get(args, $I(2+(i*2)+0)), get(args, $I(2+(i*2)+1)));
+    }
+    FrozenTable_Build(t, pairs);
+  } catch (e) {
+    var msg = exception_message();
+    del_raw(pairs);
+    throw(e, "%s", msg);
+  }
+  
+  del_raw(pairs);
+}
+
+static void FrozenTable_Del(var self) {
+  FrozenTable_Clear(self);
+}
+
+static void FrozenTable_Assign(var self, var obj) {
+  struct FrozenTable* t = self;
+  if (self is obj) { return; }
+  
+  FrozenTable_Clear(t);
+  t->ktype = implements_method(obj, Get, key_type) ? key_type(obj) : Ref;
+  t->vtype = implements_method(obj, Get, val_type) ? val_type(obj) : Ref;
+  t->ksize = FrozenTable_Size_Round(size(t->ktype));
+  t->vsize = FrozenTable_Size_Round(size(t->vtype));
+  
+  FrozenTable_Build(t, obj);
+}
+
+var freeze(var self) {
+  return assign(new(FrozenTable, Ref, Ref), self);
+}
+
+static var FrozenTable_Key_Type(var self) {
+  struct FrozenTable* t = self;
+  return t->ktype;
+}
+
+static var FrozenTable_Val_Type(var self) {
+  struct FrozenTable* t = self;
+  return t->vtype;
+}
+
+/*
+**  A lookup checks the one slot its hash leads to. Only if that holds the
+**  same hash but another key can the key be among those stored after the
+**  slots, so `FrozenTable_Next` moves from the slot to those entries.
+*/
+
+static size_t FrozenTable_Index(struct FrozenTable* t, uint64_t h) {
+  uint64_t x = FrozenTable_Mix(h);
+  return FrozenTable_Slot(t->nslots, x, t->pilots[FrozenTable_Bucket(t, x)]);
+}
+
+static size_t FrozenTable_Next(struct FrozenTable* t, size_t i) {
+  return i < t->nslots ? t->nslots : i+1;
+}
+
+static var FrozenTable_Try_Get_Int(var self, int64_t key) {
+  struct FrozenTable* t = self;
+  
+  if (t->nitems is 0) { return NULL; }
+  
+  uint64_t h = (uint64_t)key;
+  size_t i = FrozenTable_Index(t, h);
+  if (FrozenTable_Entry_Hash(t, i) isnt h) { return NULL; }
+  
+  for (; i < t->nitems; i = FrozenTable_Next(t, i)) {
+    if (FrozenTable_Entry_Hash(t, i) is h
+    and ((struct Int*)FrozenTable_Key(t, i))->val is key) {
+      return FrozenTable_Val(t, i);
+    }
+  }
+  
+  return NULL;
+}
+
+static var FrozenTable_Try_Get_CStr(var self, const char* key, size_t n) {
+  struct FrozenTable* t = self;
+  
+  if (t->nitems is 0) { return NULL; }
+  
+  uint64_t h = hash_data(key, n);
+  size_t i = FrozenTable_Index(t, h);
+  if (FrozenTable_Entry_Hash(t, i) isnt h) { return NULL; }
+  
+  for (; i < t->nitems; i = FrozenTable_Next(t, i)) {
+    char* k = ((struct String*)FrozenTable_Key(t, i))->val;
+    if (FrozenTable_Entry_Hash(t, i) is h
+    and strlen(k) is n and memcmp(k, key, n) is 0) {
+      return FrozenTable_Val(t, i);
+    }
+  }
+  
+  return NULL;
+}
+
+static var FrozenTable_Try_Get(var self, var key) {
+  struct FrozenTable* t = self;
+  
+  if (t->nitems is 0) { return NULL; }
+  
+  if (t->ktype is String and type_of(key) is String) {
+    char* k = ((struct String*)key)->val;
+    return FrozenTable_Try_Get_CStr(self, k, strlen(k));
+  }
+  
+  if (t->ktype is Int and type_of(key) is Int) {
+    return FrozenTable_Try_Get_Int(self, ((struct Int*)key)->val);
+  }
+  
+  key = cast(key, t->ktype);
+  
+  uint64_t h = hash(key);
+  size_t i = FrozenTable_Index(t, h);
+  if (FrozenTable_Entry_Hash(t, i) isnt h) { return NULL; }
+  
+  for (; i < t->nitems; i = FrozenTable_Next(t, i)) {
+    if (FrozenTable_Entry_Hash(t, i) is h and eq(FrozenTable_Key(t, i), key)) {
+      return FrozenTable_Val(t, i);
+    }
+  }
+  
+  return NULL;
+}
+
+static var FrozenTable_Get(var self, var key) {
+  var val = FrozenTable_Try_Get(self, key);
+  if (val is NULL) {
+    return throw(KeyError, "Key %$ not in FrozenTable!", key);
+  }
+  return val;
+}
+
+static bool FrozenTable_Mem(var self, var key) {
+  return FrozenTable_Try_Get(self, key) isnt NULL;
+}
+
+static void FrozenTable_Set(var self, var key, var val) {
+  throw(ValueError, "Cannot set key %$ in FrozenTable!", key);
+}
+
+static void FrozenTable_Rem(var self, var key) {
+  throw(ValueError, "Cannot remove key %$ from FrozenTable!", key);
+}
+
+static size_t FrozenTable_Len(var self) {
+  struct FrozenTable* t = self;
+  return t->nitems;
+}
+
+static var FrozenTable_Iter_Init(var self) {
+  struct FrozenTable* t = self;
+  if (t->nitems is 0) { return Terminal; }
+  return FrozenTable_Key(t, 0);
+}
+
+static var FrozenTable_Iter_Next(var self, var curr) {
+  struct FrozenTable* t = self;
+  size_t i = ((char*)curr - (char*)t->entries) / FrozenTable_Step(t);
+  if (i+1 >= t->nitems) { return Terminal; }
+  return FrozenTable_Key(t, i+1);
+}
+
+static var FrozenTable_Iter_Type(var self) {
+  struct FrozenTable* t = self;
+  return t->ktype;
+}
+
+static var FrozenTable_Iter_Val(var self, var curr) {
+  struct FrozenTable* t = self;
+  return (char*)curr + t->ksize + sizeof(struct Header);
+}
+
+static int FrozenTable_Cmp(var self, var obj) {
+  
+  int c;
+  var item0 = FrozenTable_Iter_Init(self);
+  var item1 = iter_init(obj);
+  
+  while (true) {
+    if (item0 is Terminal and item1 is Terminal) { return 0; }
+    if (item0 is Terminal) { return -1; }
+    if (item1 is Terminal) { return  1; }
+    c = cmp(item0, item1);
+    if (c < 0) { return -1; }
+    if (c > 0) { return  1; }
+    c = cmp(FrozenTable_Iter_Val(self, item0), iter_val(obj, item1));
+    if (c < 0) { return -1; }
+    if (c > 0) { return  1; }
+    item0 = FrozenTable_Iter_Next(self, item0);
+    item1 = iter_next(obj, item1);
+  }
+  
+  return 0;
+  
+}
+
+static uint64_t FrozenTable_Hash(var self) {
+  struct FrozenTable* t = self;
+  uint64_t h = 0;
+  
+  for (size_t i = 0; i < t->nitems; i++) {
+    h += hash_combine(
+      FrozenTable_Entry_Hash(t, i), hash(FrozenTable_Val(t, i)));
+  }
+  
+  return h;
+}
+
+static int FrozenTable_Show(var self, var output, int pos) {
+  struct FrozenTable* t = self;
+  
+  pos = print_to(output, pos, "<'FrozenTable' At 0x%p {", self);
+  
+  for (size_t i = 0; i < t->nitems; i++) {
+    pos = print_to(output, pos, "%$:%$",
+      FrozenTable_Key(t, i), FrozenTable_Val(t, i));
+    if (i < t->nitems-1) { pos = print_to(output, pos, ", "); }
+  }
+  
+  return print_to(output, pos, "}>");
+}
+
+static void FrozenTable_Mark(var self, var gc, void(*f)(var,void*)) {
+  struct FrozenTable* t = self;
+  for (size_t i = 0; i < t->nitems; i++) {
+    f(gc, FrozenTable_Key(t, i));
+    f(gc, FrozenTable_Val(t, i));
+  }
+}
+
+var FrozenTable = Cello(FrozenTable,
+  Instance(Doc,
+    FrozenTable_Name, FrozenTable_Brief,    FrozenTable_Description,
+    NULL,             FrozenTable_Examples, FrozenTable_Methods),
+  Instance(New,      FrozenTable_New, FrozenTable_Del),
+  Instance(Assign,   FrozenTable_Assign),
+  Instance(Mark,     FrozenTable_Mark),
+  Instance(Cmp,      FrozenTable_Cmp),
+  Instance(Hash,     FrozenTable_Hash),
+  Instance(Len,      FrozenTable_Len),
+  Instance(Get,
+    FrozenTable_Get, FrozenTable_Set, FrozenTable_Mem, FrozenTable_Rem,
+    FrozenTable_Key_Type, FrozenTable_Val_Type, FrozenTable_Try_Get, NULL,
+    FrozenTable_Try_Get_Int, FrozenTable_Try_Get_CStr),
+  Instance(Iter,
+    FrozenTable_Iter_Init, FrozenTable_Iter_Next,
+    NULL, NULL, FrozenTable_Iter_Type, FrozenTable_Iter_Val),
+  Instance(Show,     FrozenTable_Show, NULL));
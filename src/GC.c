@@ -53,22 +53,63 @@ void mark(var self, var gc, void(*f)(var,void*)) {
   if (m and m->mark) { m->mark(self, gc, f); }
 }
 
+static const char* Finalize_Name(void) {
+  return "Finalize";
+}
+
+static const char* Finalize_Brief(void) {
+  return "Thread Affine Destruction";
+}
+
+static const char* Finalize_Description(void) {
+  return
+    "The `Finalize` class can be implemented by types which care about which "
+    "thread runs their destructor when they are collected by the Garbage "
+    "Collector."
+    "\n\n"
+    "When a Garbage Collector has asynchronous finalization turned on using "
+    "`gc_finalize_async` unreachable objects are handed to a background "
+    "finalizer thread which calls `destruct` and `dealloc` on them. If the "
+    "`local` method returns `true` for an object then it is instead destructed "
+    "by the thread which owns the Garbage Collector, as it would be without "
+    "asynchronous finalization.";
+}
+
+static const char* Finalize_Definition(void) {
+  return
+    "struct Finalize {\n"
+    "  bool (*local)(var);\n"
+    "};\n";
+}
+
+static struct Example* Finalize_Examples(void) {
+  
+  static struct Example examples[] = {
+    {
+      "Usage",
+      "static bool Window_Local(var self) {\n"
+      "  return true; /* Destruct on the UI thread */\n"
+      "}\n"
+      "\n"
+      "var Window = Cello(Window,\n"
+      "  Instance(New,      Window_New, Window_Del),\n"
+      "  Instance(Finalize, Window_Local));\n"
+    }, {NULL, NULL}
+  };
+
+  return examples;
+  
+}
+
+var Finalize = Cello(Finalize, Instance(Doc, 
+  Finalize_Name,       Finalize_Brief,    Finalize_Description, 
+  Finalize_Definition, Finalize_Examples, NULL));
+
 #ifndef CELLO_NGC
   
 #define GC_TLS_KEY "__GC"
 
-enum {
-  GC_PRIMES_COUNT = 24
-};
-
-static const size_t GC_Primes[GC_PRIMES_COUNT] = {
-  0,       1,       5,       11,
-  23,      53,      101,     197,
-  389,     683,     1259,    2417,
-  4733,    9371,    18617,   37097,
-  74093,   148073,  296099,  592019,
-  1100009, 2200013, 4400021, 8800019
-};
+static CELLO_THREAD_LOCAL struct GC* GC_Local = NULL;
 
 static const char* GC_Name(void) {
   return "GC";
@@ -84,7 +125,30 @@ static const char* GC_Description(void) {
     "instance of this type is created for each thread and can be retrieved "
     "using the `current` function. The Garbage Collector can be stopped and "
     "started using `start` and `stop` and objects can be added or removed from "
-    "the Garbage Collector using `set` and `rem`.";
+    "the Garbage Collector using `set` and `rem`."
+    "\n\n"
+    "By default unreachable objects are destructed and deallocated by the "
+    "thread which triggered the collection. Calling `gc_finalize_async` hands "
+    "them instead to a single background finalizer thread, which takes "
+    "expensive destructors off the critical path. Types which must be "
+    "destructed on their own thread can opt out using the `Finalize` class."
+    "\n\n"
+    "Objects of type `WeakRef` which are reachable from the heap are not "
+    "traced. Once marking is complete any of them which point to an "
+    "unreachable object are set to `NULL` before any object is destructed."
+    "\n\n"
+    "Variables can be registered as precise roots with `gc_root_push` or the "
+    "scoped `Root` type, and conservative scanning of the stack can be turned "
+    "off per thread using `gc_stack_scan`, leaving only registered roots."
+    "\n\n"
+    "Calling `gc_shared` turns a Garbage Collector into a heap shared by every "
+    "`Thread` started afterwards, so objects can be passed freely between "
+    "threads. A thread which triggers a collection stops the world: it waits "
+    "until every other thread is parked at a safepoint, then scans all of "
+    "their stacks. Allocation, `foreach` and `gc_safepoint` are safepoints, "
+    "and `join` and `lock` are safe regions in which a blocked thread counts "
+    "as parked. Long loops which do none of these should call `gc_safepoint`. "
+    "Threads not created as a Cello `Thread` cannot use a shared heap.";
 }
 
 static struct Example* GC_Examples(void) {
@@ -98,6 +162,20 @@ static struct Example* GC_Examples(void) {
       "show($I(running(gc))); /* 0 */\n"
       "del(x); /* Must be deleted when done */\n"
       "start(gc);\n"
+    }, {
+      "Asynchronous Finalization",
+      "var gc = current(GC);\n"
+      "gc_finalize_async(gc, true);\n"
+      "/* Destructors run on the finalizer thread */\n"
+      "gc_finalize_async(gc, false);\n"
+      "/* Waits for any pending destructors to finish */\n"
+    }, {
+      "Shared Heap",
+      "gc_shared(current(GC), true);\n"
+      "var t = new(Thread, $(Function, worker));\n"
+      "call(t); /* Allocates into the shared heap */\n"
+      "join(t);\n"
+      "gc_shared(current(GC), false);\n"
     }, {NULL, NULL}
   };
 
@@ -105,6 +183,53 @@ static struct Example* GC_Examples(void) {
   
 }
 
+static struct Method* GC_Methods(void) {
+  
+  static struct Method methods[] = {
+    {
+      "gc_finalize_async", 
+      "void gc_finalize_async(var self, bool async);",
+      "Turn on or off asynchronous finalization for the Garbage Collector "
+      "`self`. When turned off this waits for all objects already queued to "
+      "the finalizer thread to be destructed."
+    }, {
+      "gc_shared", 
+      "void gc_shared(var self, bool shared);",
+      "When `shared` is `true` make the Garbage Collector `self` the heap which "
+      "threads started afterwards allocate into. When `false` threads started "
+      "afterwards get a private Garbage Collector again. Threads already "
+      "attached must be joined before `self` is deleted."
+    }, {
+      "gc_root_push", 
+      "void gc_root_push(var self, var* ref);\n"
+      "void gc_root_pop(var self);",
+      "Push or pop the address of a variable on the root stack of the Garbage "
+      "Collector `self`. The object each registered variable points to is "
+      "marked on every collection. See `Root` for a scoped version."
+    }, {
+      "gc_stack_scan", 
+      "void gc_stack_scan(var self, bool scan);",
+      "Turn conservative scanning of the calling thread's stack and registers "
+      "on or off for the Garbage Collector `self`. When off only roots are "
+      "marked, which makes collections cheaper and avoids false retention."
+    }, {
+      "gc_safepoint", 
+      "#define gc_safepoint()",
+      "Park the calling thread if another thread is waiting to collect a "
+      "shared heap. This is a single flag check otherwise."
+    }, {
+      "gc_safe_enter", 
+      "void gc_safe_enter(void);\n"
+      "void gc_safe_leave(void);",
+      "Mark a region in which the calling thread may block without touching "
+      "the Garbage Collector, letting collections proceed without it. Objects "
+      "must not be allocated or modified inside the region."
+    }, {NULL, NULL, NULL}
+  };
+  
+  return methods;
+}
+
 struct GCEntry {
   var ptr;
   uint64_t hash;
@@ -112,38 +237,55 @@ struct GCEntry {
   bool marked;
 };
 
+enum {
+  GC_PENDING = 64
+};
+
 struct GC {
   struct GCEntry* entries;
   size_t nslots;
+  size_t nshift;
   size_t nitems;
   size_t mitems;
   uintptr_t maxptr;
   uintptr_t minptr;
   var bottom;
   bool running;
+  bool async;
   uintptr_t freenum;
   var* freelist;
+  size_t weaknum;
+  size_t weakmax;
+  var* weaklist;
+  struct GC* heap;
+  struct GC* next;
+  struct GC* threads;
+  size_t nthreads;
+  size_t nsafe;
+  size_t depth;
+  bool shared;
+  var thread;
+  var top;
+  jmp_buf regs;
+  var** roots;
+  size_t nroots;
+  size_t mroots;
+  bool scan;
+  var pending[GC_PENDING];
+  size_t npending;
 };
 
 static uint64_t GC_Probe(struct GC* gc, uint64_t i, uint64_t h) {
-  int64_t v = i - (h-1);
-  if (v < 0) {
-    v = gc->nslots + v;
-  }
-  return v;
+  return (i - (h-1)) & (gc->nslots-1);
 }
 
 static const double GC_Load_Factor = 0.9;
 
 static size_t GC_Ideal_Size(size_t size) {
   size = (size_t)((double)(size+1) / GC_Load_Factor);
-  for (size_t i = 0; i < GC_PRIMES_COUNT; i++) {
-    if (GC_Primes[i] >= size) { return GC_Primes[i]; }
-  }
-  size_t last = GC_Primes[GC_PRIMES_COUNT-1];
-  for (size_t i = 0;; i++) {
-    if (last * i >= size) { return last * i; }
-  }
+  size_t n = 2;
+  while (n < size) { n = n * 2; }
+  return n;
 }
 
 static void GC_Set_Ptr(struct GC* gc, var ptr, bool root);
@@ -154,6 +296,8 @@ static void GC_Rehash(struct GC* gc, size_t new_size) {
   size_t old_size = gc->nslots;
   
   gc->nslots = new_size;
+  gc->nshift = 64;
+  while (new_size > 1) { new_size = new_size / 2; gc->nshift--; }
   gc->entries = calloc(gc->nslots, sizeof(struct GCEntry));
   
 #if CELLO_MEMORY_CHECK == 1
@@ -185,13 +329,15 @@ static void GC_Resize_Less(struct GC* gc) {
   if (new_size < old_size) { GC_Rehash(gc, new_size); }
 }
 
-static uint64_t GC_Hash(var ptr) {
-  return ((uintptr_t)ptr) >> 3;
+/* Fibonacci hashing of the pointer, as allocations are 8 byte aligned */
+
+static uint64_t GC_Home(struct GC* gc, var ptr) {
+  return ((((uintptr_t)ptr) >> 3) * 0x9E3779B97F4A7C15ull) >> gc->nshift;
 }
 
 static void GC_Set_Ptr(struct GC* gc, var ptr, bool root) {
   
-  uint64_t i = GC_Hash(ptr) % gc->nslots;
+  uint64_t i = GC_Home(gc, ptr);
   uint64_t j = 0;
   uint64_t ihash = i+1;
   struct GCEntry entry = { ptr, ihash, root, 0 };
@@ -210,7 +356,7 @@ static void GC_Set_Ptr(struct GC* gc, var ptr, bool root) {
       j = p;
     }
     
-    i = (i+1) % gc->nslots;
+    i = (i+1) & (gc->nslots-1);
     j++;
   }
   
@@ -220,14 +366,14 @@ static bool GC_Mem_Ptr(struct GC* gc, var ptr) {
 
   if (gc->nslots is 0) { return false; }
   
-  uint64_t i = GC_Hash(ptr) % gc->nslots;
+  uint64_t i = GC_Home(gc, ptr);
   uint64_t j = 0;
   
   while (true) {
     uint64_t h = gc->entries[i].hash;
     if (h is 0 or j > GC_Probe(gc, i, h)) { return false; }
     if (gc->entries[i].ptr == ptr) { return true; }
-    i = (i+1) % gc->nslots; j++;
+    i = (i+1) & (gc->nslots-1); j++;
   }
 
 }
@@ -240,7 +386,7 @@ static void GC_Rem_Ptr(struct GC* gc, var ptr) {
     if (gc->freelist[i] is ptr) { gc->freelist[i] = NULL; }
   }
   
-  uint64_t i = GC_Hash(ptr) % gc->nslots;
+  uint64_t i = GC_Home(gc, ptr);
   uint64_t j = 0;
   
   while (true) {
@@ -254,7 +400,7 @@ static void GC_Rem_Ptr(struct GC* gc, var ptr) {
       
       j = i;
       while (true) { 
-        uint64_t nj = (j+1) % gc->nslots;
+        uint64_t nj = (j+1) & (gc->nslots-1);
         uint64_t nh = gc->entries[nj].hash;
         if (nh isnt 0 and GC_Probe(gc, nj, nh) > 0) {
           memcpy(&gc->entries[j], &gc->entries[nj], sizeof(struct GCEntry));
@@ -271,7 +417,7 @@ static void GC_Rem_Ptr(struct GC* gc, var ptr) {
       return;
     }
     
-    i = (i+1) % gc->nslots; j++;
+    i = (i+1) & (gc->nslots-1); j++;
   }
   
 }
@@ -284,6 +430,22 @@ static void GC_Mark_And_Recurse(struct GC* gc, void* ptr) {
   GC_Recurse(gc, ptr);
 }
 
+static void GC_Weak(struct GC* gc, var ptr) {
+  
+  if (gc->weaknum is gc->weakmax) {
+    gc->weakmax = gc->weakmax + gc->weakmax / 2 + 8;
+    gc->weaklist = realloc(gc->weaklist, sizeof(var) * gc->weakmax);
+#if CELLO_MEMORY_CHECK == 1
+    if (gc->weaklist is NULL) {
+      throw(OutOfMemoryError, "Cannot grow GC Weak List, out of memory!");
+    }
+#endif
+  }
+  
+  gc->weaklist[gc->weaknum] = ptr;
+  gc->weaknum++;
+}
+
 static void GC_Recurse(struct GC* gc, var ptr) {
   
   var type = type_of(ptr);
@@ -292,6 +454,11 @@ static void GC_Recurse(struct GC* gc, var ptr) {
   or  type is String or  type is Type
   or  type is File   or  type is Process
   or  type is Function) { return; }
+  
+  if (type is WeakRef) {
+    GC_Weak(gc, ptr);
+    return;
+  }
     
   struct Mark* m = type_instance(type, Mark);
   if (m and m->mark) {
@@ -315,7 +482,7 @@ static void GC_Mark_Item(struct GC* gc, void* ptr) {
   or  pval < gc->minptr
   or  pval > gc->maxptr) { return; }
   
-  uint64_t i = GC_Hash(ptr) % gc->nslots;
+  uint64_t i = GC_Home(gc, ptr);
   uint64_t j = 0;
   
   while (true) {
@@ -330,16 +497,12 @@ static void GC_Mark_Item(struct GC* gc, void* ptr) {
       return;
     }
     
-    i = (i+1) % gc->nslots; j++;
+    i = (i+1) & (gc->nslots-1); j++;
   }
   
 }
 
-static void GC_Mark_Stack(struct GC* gc) {
-  
-  var stk = NULL;
-  var bot = gc->bottom;
-  var top = &stk;
+static void GC_Mark_Range(struct GC* gc, var bot, var top) {
   
   if (bot == top) { return; }
   
@@ -357,9 +520,41 @@ static void GC_Mark_Stack(struct GC* gc) {
   
 }
 
-static void GC_Mark_Stack_Fake(struct GC* gc) { }
+static void GC_Mark_Stack(struct GC* gc, struct GC* rec) {
+  var stk = NULL;
+  GC_Mark_Range(gc, rec->bottom, &stk);
+}
+
+static void GC_Mark_Stack_Fake(struct GC* gc, struct GC* rec) { }
+
+static void GC_Mark_Roots(struct GC* gc, struct GC* rec) {
+  for (size_t i = 0; i < rec->nroots; i++) {
+    GC_Mark_Item(gc, *rec->roots[i]);
+  }
+}
+
+/*
+**  In a shared heap every other registered thread is parked at a safepoint
+**  or inside a safe region. Each recorded the top of its stack and flushed
+**  its registers into `regs` before doing so.
+*/
+
+static void GC_Mark_Threads(struct GC* gc, struct GC* rec) {
+  
+  for (struct GC* t = gc->threads; t isnt NULL; t = t->next) {
+    if (t is rec) { continue; }
+    mark(t->thread, gc, (void(*)(var,void*))GC_Mark_Item);
+    GC_Mark_Roots(gc, t);
+    if (not t->scan) { continue; }
+    for (size_t i = 0; i < sizeof(jmp_buf) / (sizeof(var)); i++) {
+      GC_Mark_Item(gc, ((var*)&t->regs)[i]);
+    }
+    GC_Mark_Range(gc, t->bottom, t->top);
+  }
+  
+}
 
-void GC_Mark(struct GC* gc) {
+void GC_Mark(struct GC* gc, struct GC* rec) {
   
   if (gc is NULL or gc->nitems is 0) { return; }
   
@@ -376,6 +571,9 @@ void GC_Mark(struct GC* gc) {
     }
   }
   
+  /* Mark Registered Roots */
+  GC_Mark_Roots(gc, rec);
+  
   volatile int noinline = 1;
   
   /* Flush Registers to Stack */
@@ -386,17 +584,20 @@ void GC_Mark(struct GC* gc) {
   }
   
   /* Avoid Inlining function call */
-  void (*mark_stack)(struct GC* gc) = noinline
-    ? GC_Mark_Stack
-    : (void(*)(struct GC* gc))(NULL);
+  void (*mark_stack)(struct GC* gc, struct GC* rec) = noinline
+    ? (rec->scan ? GC_Mark_Stack : GC_Mark_Stack_Fake)
+    : (void(*)(struct GC* gc, struct GC* rec))(NULL);
   
   /* Mark Stack */
-  mark_stack(gc);
+  mark_stack(gc, rec);
+  
+  /* Mark Other Threads */
+  if (gc->shared) { GC_Mark_Threads(gc, rec); }
   
 }
 
 static int GC_Show(var self, var out, int pos) {
-  struct GC* gc = self;
+  struct GC* gc = ((struct GC*)self)->heap;
  
   pos = print_to(out, pos, "<'GC' At 0x%p\n", self);
   for (size_t i = 0; i < gc->nslots; i++) {
@@ -414,8 +615,574 @@ static int GC_Show(var self, var out, int pos) {
   return print_to(out, pos, "+------------------->\n");
 }
 
+/*
+**  A shared heap is a Garbage Collector which other threads attach to when
+**  they start, instead of creating their own. Every operation on it takes
+**  the world lock, except allocation, which appends to a buffer local to
+**  the thread and only takes the lock to move a full buffer into the heap.
+**  A thread which wants to collect sets `Cello_Safepoint` and waits until
+**  every other attached thread is parked, either at a safepoint or inside
+**  a safe region around a blocking call, then moves every buffer into the
+**  heap before marking.
+**
+**  Each attached thread keeps its own `GC` object, retrieved as usual with
+**  `current(GC)`, which records its stack and forwards to the heap. It also
+**  counts how deeply it holds the world lock so that destructors run by a
+**  sweep can call back into the collector.
+*/
+
+volatile bool Cello_Safepoint = false;
+
+static struct GC* GC_Shared = NULL;
+static bool GC_Shared_Used = false;
+
+#if defined(CELLO_UNIX)
+
+static pthread_mutex_t GC_World_Mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t GC_World_Parked = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t GC_World_Resume = PTHREAD_COND_INITIALIZER;
+
+static void GC_World_Lock(void) {
+  pthread_mutex_lock(&GC_World_Mutex);
+}
+
+static void GC_World_Unlock(void) {
+  pthread_mutex_unlock(&GC_World_Mutex);
+}
+
+static void GC_World_Wait_Parked(void) {
+  pthread_cond_wait(&GC_World_Parked, &GC_World_Mutex);
+}
+
+static void GC_World_Wait_Resume(void) {
+  pthread_cond_wait(&GC_World_Resume, &GC_World_Mutex);
+}
+
+static void GC_World_Signal_Parked(void) {
+  pthread_cond_signal(&GC_World_Parked);
+}
+
+static void GC_World_Signal_Resume(void) {
+  pthread_cond_broadcast(&GC_World_Resume);
+}
+
+#elif defined(CELLO_WINDOWS)
+
+static SRWLOCK GC_World_Mutex = SRWLOCK_INIT;
+static CONDITION_VARIABLE GC_World_Parked = CONDITION_VARIABLE_INIT;
+static CONDITION_VARIABLE GC_World_Resume = CONDITION_VARIABLE_INIT;
+
+static void GC_World_Lock(void) {
+  AcquireSRWLockExclusive(&GC_World_Mutex);
+}
+
+static void GC_World_Unlock(void) {
+  ReleaseSRWLockExclusive(&GC_World_Mutex);
+}
+
+static void GC_World_Wait_Parked(void) {
+  SleepConditionVariableSRW(&GC_World_Parked, &GC_World_Mutex, INFINITE, 0);
+}
+
+static void GC_World_Wait_Resume(void) {
+  SleepConditionVariableSRW(&GC_World_Resume, &GC_World_Mutex, INFINITE, 0);
+}
+
+static void GC_World_Signal_Parked(void) {
+  WakeConditionVariable(&GC_World_Parked);
+}
+
+static void GC_World_Signal_Resume(void) {
+  WakeAllConditionVariable(&GC_World_Resume);
+}
+
+#else
+
+static void GC_World_Lock(void) {}
+static void GC_World_Unlock(void) {}
+static void GC_World_Wait_Parked(void) {}
+static void GC_World_Wait_Resume(void) {}
+static void GC_World_Signal_Parked(void) {}
+static void GC_World_Signal_Resume(void) {}
+
+#endif
+
+static void GC_Add(struct GC* gc, var key, bool root) {
+  gc->nitems++;
+  gc->maxptr = (uintptr_t)key > gc->maxptr ? (uintptr_t)key : gc->maxptr;
+  gc->minptr = (uintptr_t)key < gc->minptr ? (uintptr_t)key : gc->minptr;
+  GC_Resize_More(gc);
+  GC_Set_Ptr(gc, key, root);
+}
+
+static void GC_Flush(struct GC* gc, struct GC* rec) {
+  for (size_t i = 0; i < rec->npending; i++) {
+    GC_Add(gc, rec->pending[i], false);
+  }
+  rec->npending = 0;
+}
+
+static void GC_Flush_Threads(struct GC* gc) {
+  for (struct GC* t = gc->threads; t isnt NULL; t = t->next) {
+    GC_Flush(gc, t);
+  }
+}
+
+static void GC_Park(struct GC* rec) {
+  
+  struct GC* gc = rec->heap;
+  var top = NULL;
+  
+  memset(&rec->regs, 0, sizeof(jmp_buf));
+  setjmp(rec->regs);
+  rec->top = &top;
+  
+  gc->nsafe++;
+  GC_World_Signal_Parked();
+  while (CELLO_LOAD_ACQUIRE(Cello_Safepoint)) { GC_World_Wait_Resume(); }
+  gc->nsafe--;
+  
+}
+
+static struct GC* GC_Enter(struct GC* rec) {
+  struct GC* gc = rec->heap;
+  if (not gc->shared) { return gc; }
+  if (rec->depth++ > 0) { return gc; }
+  GC_World_Lock();
+  while (CELLO_LOAD_ACQUIRE(Cello_Safepoint)) { GC_Park(rec); }
+  return gc;
+}
+
+static void GC_Leave(struct GC* rec) {
+  if (not rec->heap->shared) { return; }
+  if (--rec->depth > 0) { return; }
+  GC_World_Unlock();
+}
+
+static void GC_Stop_World(struct GC* gc) {
+  if (not gc->shared) { return; }
+  CELLO_STORE_RELEASE(Cello_Safepoint, true);
+  while (gc->nsafe + 1 < gc->nthreads) { GC_World_Wait_Parked(); }
+}
+
+static void GC_Start_World(struct GC* gc) {
+  if (not gc->shared) { return; }
+  CELLO_STORE_RELEASE(Cello_Safepoint, false);
+  GC_World_Signal_Resume();
+}
+
+static void GC_Attach(struct GC* rec) {
+  
+  GC_World_Lock();
+  
+  struct GC* gc = GC_Shared;
+  if (gc isnt NULL) {
+    while (CELLO_LOAD_ACQUIRE(Cello_Safepoint)) { GC_World_Wait_Resume(); }
+    rec->heap = gc;
+    rec->next = gc->threads;
+    gc->threads = rec;
+    gc->nthreads++;
+  }
+  
+  GC_World_Unlock();
+}
+
+static void GC_Detach(struct GC* rec) {
+  
+  struct GC* gc = rec->heap;
+  
+  GC_World_Lock();
+  while (CELLO_LOAD_ACQUIRE(Cello_Safepoint)) { GC_Park(rec); }
+  GC_Flush(gc, rec);
+  
+  struct GC** t = &gc->threads;
+  while (*t isnt rec) { t = &(*t)->next; }
+  *t = rec->next;
+  gc->nthreads--;
+  
+  GC_World_Signal_Parked();
+  GC_World_Unlock();
+}
+
+static struct GC* GC_Safe_Record(void) {
+  if (not GC_Shared_Used) { return NULL; }
+  struct GC* rec = GC_Local;
+  if (rec is NULL or not rec->heap->shared or rec->depth > 0) { return NULL; }
+  return rec;
+}
+
+void gc_safe_enter(void) {
+  
+  struct GC* rec = GC_Safe_Record();
+  if (rec is NULL) { return; }
+  
+  var top = NULL;
+  
+  GC_World_Lock();
+  memset(&rec->regs, 0, sizeof(jmp_buf));
+  setjmp(rec->regs);
+  rec->top = &top;
+  rec->heap->nsafe++;
+  GC_World_Signal_Parked();
+  GC_World_Unlock();
+  
+}
+
+void gc_safe_leave(void) {
+  
+  struct GC* rec = GC_Safe_Record();
+  if (rec is NULL) { return; }
+  
+  GC_World_Lock();
+  while (CELLO_LOAD_ACQUIRE(Cello_Safepoint)) { GC_World_Wait_Resume(); }
+  rec->heap->nsafe--;
+  GC_World_Unlock();
+  
+}
+
+void Cello_Safepoint_Park(void) {
+  
+  struct GC* rec = GC_Safe_Record();
+  if (rec is NULL) { return; }
+  
+  GC_World_Lock();
+  while (CELLO_LOAD_ACQUIRE(Cello_Safepoint)) { GC_Park(rec); }
+  GC_World_Unlock();
+  
+}
+
+/*
+**  Asynchronous finalization hands the objects found unreachable by
+**  `GC_Sweep` to a single background Cello `Thread`. The queue is shared by
+**  every Garbage Collector with `async` set. It is protected by a native
+**  lock because the finalizer must be able to sleep until there is work to
+**  do, which the Cello `Mutex` type provides no way of doing.
+**
+**  The finalizer is a normal Cello `Thread` so it has its own Garbage
+**  Collector and Exception state. Destructors which call `del` on their
+**  sub-objects only ever touch that Garbage Collector and never the one
+**  which queued them.
+*/
+
+/*
+**  Objects found unreachable are all destructed before any are deallocated.
+**  A destructor may `del` another object from the same sweep, and with
+**  `CELLO_RC` this touches its header, so it must still be in memory. Items
+**  tagged in the lowest bit have already been destructed by the thread which
+**  swept them and only need deallocating.
+*/
+
+#define GC_DESTRUCTED ((uintptr_t)1)
+
+static void GC_Free(var* items, size_t num) {
+  
+  for (size_t i = 0; i < num; i++) {
+    if (items[i] is NULL) { continue; }
+    if ((uintptr_t)items[i] & GC_DESTRUCTED) { continue; }
+    destruct(items[i]);
+  }
+  
+  for (size_t i = 0; i < num; i++) {
+    if (items[i] is NULL) { continue; }
+    dealloc((var)((uintptr_t)items[i] & ~GC_DESTRUCTED));
+  }
+  
+}
+
+#if defined(CELLO_UNIX)
+
+static pthread_mutex_t GC_Finalizer_Mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t GC_Finalizer_Wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t GC_Finalizer_Done = PTHREAD_COND_INITIALIZER;
+
+static void GC_Finalizer_Lock(void) {
+  pthread_mutex_lock(&GC_Finalizer_Mutex);
+}
+
+static void GC_Finalizer_Unlock(void) {
+  pthread_mutex_unlock(&GC_Finalizer_Mutex);
+}
+
+static void GC_Finalizer_Wait_Wake(void) {
+  pthread_cond_wait(&GC_Finalizer_Wake, &GC_Finalizer_Mutex);
+}
+
+static void GC_Finalizer_Wait_Done(void) {
+  pthread_cond_wait(&GC_Finalizer_Done, &GC_Finalizer_Mutex);
+}
+
+static void GC_Finalizer_Signal_Wake(void) {
+  pthread_cond_signal(&GC_Finalizer_Wake);
+}
+
+static void GC_Finalizer_Signal_Done(void) {
+  pthread_cond_broadcast(&GC_Finalizer_Done);
+}
+
+#elif defined(CELLO_WINDOWS)
+
+static SRWLOCK GC_Finalizer_Mutex = SRWLOCK_INIT;
+static CONDITION_VARIABLE GC_Finalizer_Wake = CONDITION_VARIABLE_INIT;
+static CONDITION_VARIABLE GC_Finalizer_Done = CONDITION_VARIABLE_INIT;
+
+static void GC_Finalizer_Lock(void) {
+  AcquireSRWLockExclusive(&GC_Finalizer_Mutex);
+}
+
+static void GC_Finalizer_Unlock(void) {
+  ReleaseSRWLockExclusive(&GC_Finalizer_Mutex);
+}
+
+static void GC_Finalizer_Wait_Wake(void) {
+  SleepConditionVariableSRW(
+    &GC_Finalizer_Wake, &GC_Finalizer_Mutex, INFINITE, 0);
+}
+
+static void GC_Finalizer_Wait_Done(void) {
+  SleepConditionVariableSRW(
+    &GC_Finalizer_Done, &GC_Finalizer_Mutex, INFINITE, 0);
+}
+
+static void GC_Finalizer_Signal_Wake(void) {
+  WakeConditionVariable(&GC_Finalizer_Wake);
+}
+
+static void GC_Finalizer_Signal_Done(void) {
+  WakeAllConditionVariable(&GC_Finalizer_Done);
+}
+
+#endif
+
+#if defined(CELLO_UNIX) || defined(CELLO_WINDOWS)
+
+/*
+**  The finalizer thread is started by the first push and stopped when a
+**  heap is deleted, which includes the main heap at exit. Stopping sets
+**  `GC_Finalizer_Stop`, after which the thread drains the queue and returns
+**  so it can be joined. Items pushed while it stops are freed directly.
+**
+**  The thread is created and started outside the lock, with `Starting`
+**  set meanwhile so that a concurrent stop waits rather than joining a
+**  thread which does not exist yet.
+*/
+
+static var GC_Finalizer_Func = NULL;
+static var GC_Finalizer_Thread = NULL;
+static var* GC_Finalizer_Queue = NULL;
+static size_t GC_Finalizer_Num = 0;
+static size_t GC_Finalizer_Max = 0;
+static bool GC_Finalizer_Busy = false;
+static bool GC_Finalizer_Stop = false;
+static bool GC_Finalizer_Starting = false;
+static CELLO_THREAD_LOCAL bool GC_Finalizer_Self = false;
+
+static var GC_Finalizer_Run(var args) {
+  
+  GC_Finalizer_Self = true;
+  
+  while (true) {
+    
+    gc_safe_enter();
+    GC_Finalizer_Lock();
+    
+    GC_Finalizer_Busy = false;
+    GC_Finalizer_Signal_Done();
+    
+    while (GC_Finalizer_Num is 0 and not GC_Finalizer_Stop) {
+      GC_Finalizer_Wait_Wake();
+    }
+    
+    if (GC_Finalizer_Num is 0) {
+      GC_Finalizer_Unlock();
+      gc_safe_leave();
+      break;
+    }
+    
+    var* batch = GC_Finalizer_Queue;
+    size_t nbatch = GC_Finalizer_Num;
+    GC_Finalizer_Queue = NULL;
+    GC_Finalizer_Num = 0;
+    GC_Finalizer_Max = 0;
+    GC_Finalizer_Busy = true;
+    
+    GC_Finalizer_Unlock();
+    gc_safe_leave();
+    
+    GC_Free(batch, nbatch);
+    free(batch);
+  }
+  
+  return NULL;
+}
+
+static void GC_Finalizer_Push(var* items, size_t num) {
+  
+  if (num is 0) { return; }
+  
+  GC_Finalizer_Lock();
+  
+  if (GC_Finalizer_Stop) {
+    GC_Finalizer_Unlock();
+    GC_Free(items, num);
+    return;
+  }
+  
+  var start = NULL;
+  if (GC_Finalizer_Thread is NULL) {
+    GC_Finalizer_Func = new_raw(Function, $(Function, GC_Finalizer_Run));
+    GC_Finalizer_Thread = new_raw(Thread, GC_Finalizer_Func);
+    GC_Finalizer_Starting = true;
+    start = GC_Finalizer_Thread;
+  }
+  
+  if (GC_Finalizer_Num + num > GC_Finalizer_Max) {
+    GC_Finalizer_Max = GC_Finalizer_Num + num + GC_Finalizer_Num / 2;
+    GC_Finalizer_Queue = realloc(GC_Finalizer_Queue, 
+      sizeof(var) * GC_Finalizer_Max);
+#if CELLO_MEMORY_CHECK == 1
+    if (GC_Finalizer_Queue is NULL) {
+      GC_Finalizer_Unlock();
+      throw(OutOfMemoryError, "Cannot grow Finalizer Queue, out of memory!");
+    }
+#endif
+  }
+  
+  memcpy(GC_Finalizer_Queue + GC_Finalizer_Num, items, sizeof(var) * num);
+  GC_Finalizer_Num += num;
+  
+  GC_Finalizer_Signal_Wake();
+  GC_Finalizer_Unlock();
+  
+  if (start isnt NULL) {
+    call(start);
+    GC_Finalizer_Lock();
+    GC_Finalizer_Starting = false;
+    GC_Finalizer_Signal_Done();
+    GC_Finalizer_Unlock();
+  }
+  
+}
+
+static void GC_Finalizer_Wait(void) {
+  gc_safe_enter();
+  GC_Finalizer_Lock();
+  while (GC_Finalizer_Num isnt 0 or GC_Finalizer_Busy) {
+    GC_Finalizer_Wait_Done();
+  }
+  GC_Finalizer_Unlock();
+  gc_safe_leave();
+}
+
+static void GC_Finalizer_Shutdown(void) {
+  
+  /* The finalizer thread deletes its own heap as it exits */
+  if (GC_Finalizer_Self) { return; }
+  
+  gc_safe_enter();
+  GC_Finalizer_Lock();
+  
+  while (GC_Finalizer_Stop or GC_Finalizer_Starting) {
+    GC_Finalizer_Wait_Done();
+  }
+  
+  var thread = GC_Finalizer_Thread;
+  var func = GC_Finalizer_Func;
+  
+  if (thread isnt NULL) {
+    GC_Finalizer_Stop = true;
+    GC_Finalizer_Signal_Wake();
+  }
+  
+  GC_Finalizer_Unlock();
+  gc_safe_leave();
+  
+  if (thread is NULL) { return; }
+  
+  join(thread);
+  
+  gc_safe_enter();
+  GC_Finalizer_Lock();
+  GC_Finalizer_Thread = NULL;
+  GC_Finalizer_Func = NULL;
+  GC_Finalizer_Stop = false;
+  GC_Finalizer_Signal_Done();
+  GC_Finalizer_Unlock();
+  gc_safe_leave();
+  
+  del_raw(thread);
+  del_raw(func);
+}
+
+#else
+
+static void GC_Finalizer_Push(var* items, size_t num) {
+  GC_Free(items, num);
+}
+
+static void GC_Finalizer_Wait(void) {}
+static void GC_Finalizer_Shutdown(void) {}
+
+#endif
+
+static void GC_Finalize(struct GC* gc) {
+  
+  /* Objects which opt out are destructed here and deallocated later */
+  for (size_t i = 0; i < gc->freenum; i++) {
+    var ptr = gc->freelist[i];
+    if (ptr is NULL) { continue; }
+    struct Finalize* f = instance(ptr, Finalize);
+    if (f and f->local and f->local(ptr)) {
+      destruct(ptr);
+      gc->freelist[i] = (var)((uintptr_t)ptr | GC_DESTRUCTED);
+    }
+  }
+  
+  size_t num = 0;
+  for (size_t i = 0; i < gc->freenum; i++) {
+    if (gc->freelist[i]) {
+      gc->freelist[num] = gc->freelist[i];
+      num++;
+    }
+  }
+  
+  GC_Finalizer_Push(gc->freelist, num);
+  
+}
+
+static bool GC_Dead(struct GC* gc, var ptr) {
+  
+  if (gc->nslots is 0) { return false; }
+  
+  uint64_t i = GC_Home(gc, ptr);
+  uint64_t j = 0;
+  
+  while (true) {
+    uint64_t h = gc->entries[i].hash;
+    if (h is 0 or j > GC_Probe(gc, i, h)) { return false; }
+    if (gc->entries[i].ptr == ptr) {
+      return not gc->entries[i].marked and not gc->entries[i].root;
+    }
+    i = (i+1) & (gc->nslots-1); j++;
+  }
+  
+}
+
+static void GC_Clear_Weak(struct GC* gc) {
+  
+  for (size_t i = 0; i < gc->weaknum; i++) {
+    struct WeakRef* w = gc->weaklist[i];
+    if (w->val isnt NULL and GC_Dead(gc, w->val)) {
+      w->val = NULL;
+    }
+  }
+  
+  gc->weaknum = 0;
+}
+
 void GC_Sweep(struct GC* gc) {
-   
+  
+  GC_Clear_Weak(gc);
+  
   gc->freelist = realloc(gc->freelist, sizeof(var) * gc->nitems);
   gc->freenum = 0;
   
@@ -433,7 +1200,7 @@ void GC_Sweep(struct GC* gc) {
       
       uint64_t j = i;
       while (true) { 
-        uint64_t nj = (j+1) % gc->nslots;
+        uint64_t nj = (j+1) & (gc->nslots-1);
         uint64_t nh = gc->entries[nj].hash;
         if (nh isnt 0 and GC_Probe(gc, nj, nh) > 0) {
           memcpy(&gc->entries[j], &gc->entries[nj], sizeof(struct GCEntry));
@@ -462,10 +1229,16 @@ void GC_Sweep(struct GC* gc) {
   GC_Resize_Less(gc);
   gc->mitems = gc->nitems + gc->nitems / 2 + 1;
   
+#ifdef CELLO_RC
   for (size_t i = 0; i < gc->freenum; i++) {
-    if (gc->freelist[i]) {
-      dealloc(destruct(gc->freelist[i]));
-    }
+    retain(gc->freelist[i]);
+  }
+#endif
+  
+  if (gc->async) {
+    GC_Finalize(gc);
+  } else {
+    GC_Free(gc->freelist, gc->freenum);
   }
   
   free(gc->freelist);
@@ -475,6 +1248,7 @@ void GC_Sweep(struct GC* gc) {
 }
 
 static var GC_Current(void) {
+  if (GC_Local isnt NULL) { return GC_Local; }
   return get(current(Thread), $S(GC_TLS_KEY));
 }
 
@@ -485,70 +1259,288 @@ static void GC_New(var self, var args) {
   gc->maxptr = 0;
   gc->minptr = UINTPTR_MAX;
   gc->running = true;
+  gc->async = false;
   gc->freelist = NULL;
   gc->freenum = 0;
+  gc->weaknum = 0;
+  gc->weakmax = 0;
+  gc->weaklist = NULL;
+  gc->heap = gc;
+  gc->next = NULL;
+  gc->threads = NULL;
+  gc->nthreads = 0;
+  gc->nsafe = 0;
+  gc->depth = 0;
+  gc->shared = false;
+  gc->thread = current(Thread);
+  gc->top = NULL;
+  gc->roots = NULL;
+  gc->nroots = 0;
+  gc->mroots = 0;
+  gc->scan = true;
+  gc->npending = 0;
+  if (GC_Shared isnt NULL) { GC_Attach(gc); }
   set(current(Thread), $S(GC_TLS_KEY), gc);
+  GC_Local = gc;
 }
 
 static void GC_Del(var self) {
   struct GC* gc = self;
+  
+  if (gc->heap isnt gc) {
+    GC_Detach(gc);
+    free(gc->roots);
+    rem(current(Thread), $S(GC_TLS_KEY));
+    if (GC_Local is gc) { GC_Local = NULL; }
+    return;
+  }
+  
+  gc->async = false;
+  GC_Finalizer_Shutdown();
+  
+  GC_Enter(gc);
+  if (GC_Shared is gc) { GC_Shared = NULL; }
+  GC_Flush(gc, gc);
   GC_Sweep(gc);
+  GC_Leave(gc);
+  
   free(gc->entries);
   free(gc->freelist);
+  free(gc->weaklist);
+  free(gc->roots);
   rem(current(Thread), $S(GC_TLS_KEY));
+  if (GC_Local is gc) { GC_Local = NULL; }
 }
 
+/*
+**  On a shared heap a new non-root item is only appended to the buffer of
+**  the allocating thread, and the lock is taken once the buffer is full.
+**  Inside a sweep, where the lock is already held, it is added directly.
+*/
+
 static void GC_Set(var self, var key, var val) {
-  struct GC* gc = self;
-  if (not gc->running) { return; }
-  gc->nitems++;
-  gc->maxptr = (uintptr_t)key > gc->maxptr ? (uintptr_t)key : gc->maxptr;
-  gc->minptr = (uintptr_t)key < gc->minptr ? (uintptr_t)key : gc->minptr;
-  GC_Resize_More(gc);
-  GC_Set_Ptr(gc, key, (bool)c_int(val));
-  if (gc->nitems > gc->mitems) {
-    GC_Mark(gc);
+  struct GC* rec = self;
+  struct GC* gc = rec->heap;
+  bool root = (bool)c_int(val);
+  bool pending = false;
+  
+  if (gc->shared and rec->depth is 0 and not root) {
+    if (not gc->running) { return; }
+    rec->pending[rec->npending++] = key;
+    if (rec->npending < GC_PENDING) { gc_safepoint(); return; }
+    pending = true;
+  }
+  
+  /* A collection while parked here may already have flushed the buffer */
+  GC_Enter(rec);
+  if (pending) {
+    GC_Flush(gc, rec);
+  } else if (gc->running) {
+    GC_Add(gc, key, root);
+  }
+  if (gc->running and gc->nitems > gc->mitems) {
+    GC_Stop_World(gc);
+    if (gc->shared) { GC_Flush_Threads(gc); }
+    GC_Mark(gc, rec);
+    GC_Mark_Item(gc, key);
     GC_Sweep(gc);
+    GC_Start_World(gc);
   }
+  GC_Leave(rec);
+}
+
+/*
+**  An item missing from the heap may still be in the buffer of whichever
+**  thread allocated it, so the world is stopped and every buffer flushed
+**  before looking again. This only happens outside a sweep, as a sweep
+**  already runs with the world stopped and the buffers flushed.
+*/
+
+static bool GC_Find(struct GC* gc, struct GC* rec, var key) {
+  if (not gc->shared) { return GC_Mem_Ptr(gc, key); }
+  GC_Flush(gc, rec);
+  if (GC_Mem_Ptr(gc, key)) { return true; }
+  if (rec->depth > 1 or not gc->running) { return false; }
+  GC_Stop_World(gc);
+  GC_Flush_Threads(gc);
+  GC_Start_World(gc);
+  return GC_Mem_Ptr(gc, key);
 }
 
 static void GC_Rem(var self, var key) {
-  struct GC* gc = self;
-  if (not gc->running) { return; }
+  struct GC* rec = self;
+  struct GC* gc = GC_Enter(rec);
+  if (not gc->running) { GC_Leave(rec); return; }
+  if (gc->shared) { GC_Find(gc, rec, key); }
   GC_Rem_Ptr(gc, key);
   GC_Resize_Less(gc);
   gc->mitems = gc->nitems + gc->nitems / 2 + 1;
+  GC_Leave(rec);
 }
 
 static bool GC_Mem(var self, var key) {
-  return GC_Mem_Ptr(self, key);
+  struct GC* rec = self;
+  struct GC* gc = GC_Enter(rec);
+  bool found = GC_Find(gc, rec, key);
+  GC_Leave(rec);
+  return found;
 }
 
 static void GC_Start(var self) {
-  struct GC* gc = self;
+  struct GC* gc = ((struct GC*)self)->heap;
   gc->running = true;
 }
 
 static void GC_Stop(var self) {
-  struct GC* gc = self;
+  struct GC* gc = ((struct GC*)self)->heap;
   gc->running = false;
 }
 
 static bool GC_Running(var self) {
-  struct GC* gc = self;
+  struct GC* gc = ((struct GC*)self)->heap;
   return gc->running;
 }
 
 var GC = Cello(GC,
   Instance(Doc,
     GC_Name, GC_Brief,    GC_Description, 
-    NULL,    GC_Examples, NULL),
+    NULL,    GC_Examples, GC_Methods),
   Instance(New,     GC_New, GC_Del),
   Instance(Get,     NULL, GC_Set, GC_Mem, GC_Rem),
   Instance(Start,   GC_Start, GC_Stop, NULL, GC_Running),
   Instance(Show,    GC_Show, NULL),
   Instance(Current, GC_Current));
 
+void gc_finalize_async(var self, bool async) {
+  struct GC* gc = ((struct GC*)cast(self, GC))->heap;
+  gc->async = async;
+  if (not async) { GC_Finalizer_Wait(); }
+}
+
+void gc_shared(var self, bool shared) {
+  struct GC* gc = ((struct GC*)cast(self, GC))->heap;
+  
+  GC_World_Lock();
+  
+  if (shared and not gc->shared) {
+    gc->threads = gc;
+    gc->nthreads = 1;
+    gc->nsafe = 0;
+    gc->shared = true;
+  }
+  
+  if (shared) {
+    GC_Shared = gc;
+    GC_Shared_Used = true;
+  } else if (GC_Shared is gc) {
+    GC_Shared = NULL;
+  }
+  
+  GC_World_Unlock();
+}
+
+void gc_root_push(var self, var* ref) {
+  struct GC* gc = cast(self, GC);
+  
+  if (gc->nroots is gc->mroots) {
+    gc->mroots = gc->mroots + gc->mroots / 2 + 8;
+    gc->roots = realloc(gc->roots, sizeof(var*) * gc->mroots);
+#if CELLO_MEMORY_CHECK == 1
+    if (gc->roots is NULL) {
+      throw(OutOfMemoryError, "Cannot grow GC Root Stack, out of memory!");
+    }
+#endif
+  }
+  
+  gc->roots[gc->nroots] = ref;
+  gc->nroots++;
+}
+
+void gc_root_pop(var self) {
+  struct GC* gc = cast(self, GC);
+  
+#if CELLO_BOUND_CHECK == 1
+  if (gc->nroots is 0) {
+    throw(IndexOutOfBoundsError, "Cannot pop. GC Root Stack is empty!");
+  }
+#endif
+  
+  gc->nroots--;
+}
+
+void gc_stack_scan(var self, bool scan) {
+  struct GC* gc = cast(self, GC);
+  gc->scan = scan;
+}
+
+static const char* Root_Name(void) {
+  return "Root";
+}
+
+static const char* Root_Brief(void) {
+  return "Scoped Precise Root";
+}
+
+static const char* Root_Description(void) {
+  return
+    "The `Root` type registers the address of a variable with the Garbage "
+    "Collector of the current thread for the duration of a `with` block. "
+    "Whatever object the variable points to when a collection happens is "
+    "kept alive, even if the variable is reassigned inside the block."
+    "\n\n"
+    "This is mainly useful together with `gc_stack_scan`. Once stack scanning "
+    "is turned off for a thread only registered roots, objects created with "
+    "`new_root`, and objects reachable from them are kept alive, so every "
+    "local variable which must survive an allocation has to be registered."
+    "\n\n"
+    "Roots are popped in the reverse order to which they were pushed, so "
+    "`with` blocks should not be left using `goto` or by an exception.";
+}
+
+static const char* Root_Definition(void) {
+  return
+    "struct Root {\n"
+    "  var* ref;\n"
+    "};\n";
+}
+
+static struct Example* Root_Examples(void) {
+  
+  static struct Example examples[] = {
+    {
+      "Usage",
+      "gc_stack_scan(current(GC), false);\n"
+      "\n"
+      "var x = NULL;\n"
+      "with (r in $(Root, &x)) {\n"
+      "  x = new(String, $S(\"Hello\"));\n"
+      "  var y = new(Int, $I(1)); /* May collect anything not rooted */\n"
+      "  show(x); /* Hello */\n"
+      "}\n"
+      "\n"
+      "gc_stack_scan(current(GC), true);\n"
+    }, {NULL, NULL}
+  };
+  
+  return examples;
+  
+}
+
+static void Root_Start(var self) {
+  struct Root* r = self;
+  gc_root_push(current(GC), r->ref);
+}
+
+static void Root_Stop(var self) {
+  gc_root_pop(current(GC));
+}
+
+var Root = Cello(Root,
+  Instance(Doc,
+    Root_Name,       Root_Brief,    Root_Description,
+    Root_Definition, Root_Examples, NULL),
+  Instance(Start, Root_Start, Root_Stop, NULL, NULL));
+
 void Cello_Exit(void) {
   del_raw(current(GC));
 }
@@ -14,7 +14,31 @@ static const char* Get_Description(void) {
     "of an object using keys and value. Typically it is implemented by "
     "data lookup structures such as `Table` or `Map` but it is also used "
     "more generally such as using indices to look up items in `Array`, or "
-    "as thread local storage for the `Thread` object.";
+    "as thread local storage for the `Thread` object."
+    "\n\n"
+    "The `try_get` method looks up a key without throwing, returning `NULL` "
+    "when it is not found. Types can implement it directly to find the item "
+    "with a single lookup, otherwise it falls back to calling `mem` followed "
+    "by `get`."
+    "\n\n"
+    "The `get_or_insert` method returns the value stored at a key, first "
+    "setting it to a default value if the key is not found. Implemented "
+    "natively by `Table` and `Tree` this also takes just one lookup, which "
+    "suits counting and aggregating values in place."
+    "\n\n"
+    "The `_int` and `_cstr` variants look up `Int` and `String` keys given "
+    "as a raw `int64_t` or as a pointer to `n` characters. `Table` and `Tree` "
+    "implement `try_get_int`, `try_get_cstr`, `set_int` and `set_cstr` to "
+    "hash and compare the raw key directly, without boxing it or dispatching "
+    "on each probe. For other types, or other key types, the key is boxed "
+    "and the generic method is used. As a `String` cannot hold a null "
+    "character a key containing one is never found, and `set_cstr` throws "
+    "a `ValueError` for it."
+    "\n\n"
+    "The `get_many` and `mem_many` methods look up every key in `keys` and "
+    "push the results onto `out`. `Table` implements them by hashing a block "
+    "of keys and prefetching their slots before probing any of them, so the "
+    "cache misses of large tables overlap rather than happen one by one.";
 }
 
 static const char* Get_Definition(void) {
@@ -26,6 +50,14 @@ static const char* Get_Definition(void) {
     "  void (*rem)(var, var);\n"
     "  var (*key_type)(var);\n"
     "  var (*val_type)(var);\n"
+    "  var (*try_get)(var, var);\n"
+    "  var (*get_or_insert)(var, var, var);\n"
+    "  var (*try_get_int)(var, int64_t);\n"
+    "  var (*try_get_cstr)(var, const char*, size_t);\n"
+  "  void (*set_int)(var, int64_t, var);\n"
+  "  void (*set_cstr)(var, const char*, size_t, var);\n"
+    "  void (*get_many)(var, var, var);\n"
+    "  void (*mem_many)(var, var, var);\n"
     "};\n";
 }
 
@@ -55,6 +87,52 @@ static struct Example* Get_Examples(void) {
       "show(pear_price);   /* 55 */\n"
       "show(banana_price); /*  6 */\n"
       "show(apple_price);  /* 12 */\n"
+    }, {
+      "Usage 3",
+      "var prices = new(Table, String, Int, \n"
+      "  $S(\"Apple\"),  $I(12));\n"
+      "\n"
+      "show(try_get(prices, $S(\"Apple\")));      /* 12 */\n"
+      "show(get_or(prices, $S(\"Kiwi\"), $I(0))); /*  0 */\n"
+      "\n"
+      "if (try_get(prices, $S(\"Kiwi\")) is NULL) {\n"
+      "  print(\"No Kiwis!\\n\");\n"
+      "}\n"
+    }, {
+      "Counting",
+      "var counts = new(Table, String, Int);\n"
+      "\n"
+      "foreach (word in tuple($S(\"a\"), $S(\"b\"), $S(\"a\"))) {\n"
+      "  struct Int* c = get_or_insert(counts, word, $I(0));\n"
+      "  c->val++;\n"
+      "}\n"
+      "\n"
+      "show(get(counts, $S(\"a\"))); /* 2 */\n"
+    }, {
+      "Raw Keys",
+      "var ages = new(Table, String, Int, \n"
+      "  $S(\"Alice\"), $I(31));\n"
+      "\n"
+      "char* name = \"Alice Smith\";\n"
+      "show(get_cstr(ages, name, 5)); /* 31 */\n"
+      "set_cstr(ages, \"Bob\", 3, $I(42));\n"
+      "\n"
+      "var squares = new(Tree, Int, Int);\n"
+      "set_int(squares, 4, $I(16));\n"
+      "show($I(mem_int(squares, 4))); /* 1 */\n"
+    }, {
+      "Batches",
+      "var prices = new(Table, String, Int, \n"
+      "  $S(\"Apple\"),  $I(12),\n"
+      "  $S(\"Pear\"),   $I(55));\n"
+      "\n"
+      "var found = new(Array, Int);\n"
+      "mem_many(prices, tuple($S(\"Pear\"), $S(\"Kiwi\")), found);\n"
+      "show(found); /* <'Array' At 0x... [1, 0]> */\n"
+      "\n"
+      "var costs = new(Array, Int);\n"
+      "get_many(prices, tuple($S(\"Pear\"), $S(\"Apple\")), costs);\n"
+      "show(costs); /* <'Array' At 0x... [55, 12]> */\n"
     }, {NULL, NULL}
   };
 
@@ -89,6 +167,46 @@ static struct Method* Get_Methods(void) {
       "val_type", 
       "var val_type(var self);",
       "Returns the value type for the object `self`."
+    }, {
+      "try_get", 
+      "var try_get(var self, var key);",
+      "Get the value at a given `key` for object `self`, or `NULL` if the "
+      "`key` is not found."
+    }, {
+      "get_or", 
+      "var get_or(var self, var key, var def);",
+      "Get the value at a given `key` for object `self`, or `def` if the "
+      "`key` is not found."
+    }, {
+      "get_or_insert", 
+      "var get_or_insert(var self, var key, var def);",
+      "Get the value at a given `key` for object `self`, setting it to `def` "
+      "first if the `key` is not found."
+    }, {
+      "try_get_int", 
+      "var try_get_int(var self, int64_t key);\n"
+      "var get_int(var self, int64_t key);\n"
+      "bool mem_int(var self, int64_t key);\n"
+      "void set_int(var self, int64_t key, var val);",
+      "Look up or set an `Int` key given as a raw `int64_t`."
+    }, {
+      "try_get_cstr", 
+      "var try_get_cstr(var self, const char* key, size_t n);\n"
+      "var get_cstr(var self, const char* key, size_t n);\n"
+      "bool mem_cstr(var self, const char* key, size_t n);\n"
+      "void set_cstr(var self, const char* key, size_t n, var val);",
+      "Look up or set a `String` key given as the first `n` characters of "
+      "`key`."
+    }, {
+      "get_many", 
+      "void get_many(var self, var keys, var out);",
+      "Push the value of every key in `keys` onto `out`, throwing a "
+      "`KeyError` if one is not found."
+    }, {
+      "mem_many", 
+      "void mem_many(var self, var keys, var out);",
+      "Push `1` onto `out` for every key in `keys` which is a member of "
+      "`self`, and `0` for every key which is not."
     }, {NULL, NULL, NULL}
   };
   
@@ -123,3 +241,152 @@ var key_type(var self) {
 var val_type(var self) {
   return method(self, Get, val_type);  
 }
+
+var try_get(var self, var key) {
+  if (implements_method(self, Get, try_get)) {
+    return method(self, Get, try_get, key);
+  }
+  return mem(self, key) ? get(self, key) : NULL;
+}
+
+var get_or(var self, var key, var def) {
+  var val = try_get(self, key);
+  return val is NULL ? def : val;
+}
+
+var get_or_insert(var self, var key, var def) {
+  if (implements_method(self, Get, get_or_insert)) {
+    return method(self, Get, get_or_insert, key, def);
+  }
+  var val = try_get(self, key);
+  if (val isnt NULL) { return val; }
+  set(self, key, def);
+  return get(self, key);
+}
+
+var try_get_int(var self, int64_t key) {
+  if (implements_method(self, Get, try_get_int) and key_type(self) is Int) {
+    return method(self, Get, try_get_int, key);
+  }
+  return try_get(self, $I(key));
+}
+
+var get_int(var self, int64_t key) {
+  var val = try_get_int(self, key);
+  if (val is NULL) {
+    return throw(KeyError, "Key %$ not in %$!", $I(key), type_of(self));
+  }
+  return val;
+}
+
+bool mem_int(var self, int64_t key) {
+  return try_get_int(self, key) isnt NULL;
+}
+
+void set_int(var self, int64_t key, var val) {
+  if (implements_method(self, Get, set_int) and key_type(self) is Int) {
+    method(self, Get, set_int, key, val);
+    return;
+  }
+  set(self, $I(key), val);
+}
+
+static char* Get_CStr_Copy(const char* key, size_t n) {
+  
+  char* buf = malloc(n+1);
+  
+#if CELLO_MEMORY_CHECK == 1
+  if (buf is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate key, out of memory!");
+  }
+#endif
+  
+  memcpy(buf, key, n);
+  buf[n] = '\0';
+  return buf;
+}
+
+var try_get_cstr(var self, const char* key, size_t n) {
+  if (implements_method(self, Get, try_get_cstr) and key_type(self) is String) {
+    return method(self, Get, try_get_cstr, key, n);
+  }
+  if (memchr(key, '\0', n) isnt NULL) { return NULL; }
+  char* buf = Get_CStr_Copy(key, n);
+  var val = try_get(self, $S(buf));
+  free(buf);
+  return val;
+}
+
+var get_cstr(var self, const char* key, size_t n) {
+  var val = try_get_cstr(self, key, n);
+  if (val is NULL) {
+    char* buf = Get_CStr_Copy(key, n);
+    var k = new(String, $S(buf));
+    free(buf);
+    return throw(KeyError, "Key %$ not in %$!", k, type_of(self));
+  }
+  return val;
+}
+
+bool mem_cstr(var self, const char* key, size_t n) {
+  return try_get_cstr(self, key, n) isnt NULL;
+}
+
+/*
+**  Short keys are copied onto the stack, which saves an allocation. Longer
+**  keys are copied to the heap and freed again if `set` throws, as it does
+**  for a read-only container such as `FrozenTable`.
+*/
+
+void set_cstr(var self, const char* key, size_t n, var val) {
+  
+  if (memchr(key, '\0', n) isnt NULL) {
+    throw(ValueError, "Cannot set key containing a null character!");
+  }
+  
+  if (implements_method(self, Get, set_cstr) and key_type(self) is String) {
+    method(self, Get, set_cstr, key, n, val);
+    return;
+  }
+  
+  char local[128];
+  
+  if (n < sizeof(local)) {
+    memcpy(local, key, n);
+    local[n] = '\0';
+    set(self, $S(local), val);
+    return;
+  }
+  
+  char* buf = Get_CStr_Copy(key, n);
+  
+  try {
+    set(self, $S(buf), val);
+  } catch (e) {
+    var msg = exception_message();
+    free(buf);
+    throw(e, "%s", msg);
+  }
+  
+  free(buf);
+}
+
+void get_many(var self, var keys, var out) {
+  if (implements_method(self, Get, get_many)) {
+    method(self, Get, get_many, keys, out);
+    return;
+  }
+  foreach (key in keys) {
+    push(out, get(self, key));
+  }
+}
+
+void mem_many(var self, var keys, var out) {
+  if (implements_method(self, Get, mem_many)) {
+    method(self, Get, mem_many, keys, out);
+    return;
+  }
+  foreach (key in keys) {
+    push(out, $I(mem(self, key)));
+  }
+}
@@ -1,5 +1,12 @@
 #include "Cello.h"
 
+#if defined(CELLO_WINDOWS)
+#include <bcrypt.h>
+#if defined(CELLO_MSC)
+#pragma comment(lib, "bcrypt.lib")
+#endif
+#endif
+
 static const char* Hash_Name(void) {
   return "Hash";
 }
@@ -20,9 +27,26 @@ static const char* Hash_Description(void) {
     "to this it should not be used for cryptography or security."
     "\n\n"
     "By default an object is hashed by using its raw memory with the "
-    "[Murmurhash](http://en.wikipedia.org/wiki/MurmurHash) algorithm. Due to "
+    "[wyhash](https://github.com/wangyi-fudan/wyhash) algorithm. Due to "
     "the link between them it is recommended to only override `Hash` and "
-    "`Cmp` in conjunction.";
+    "`Cmp` in conjunction."
+    "\n\n"
+    "The seed used by `hash_data` is fixed by default so that hashes are the "
+    "same on every run. Programs which store untrusted keys in a `Table` "
+    "should be run with the environment variable `CELLO_HASH_SEED` set to "
+    "`random`, or to a number, which stops an attacker from choosing keys "
+    "that all collide. A `random` seed is read from the operating system's "
+    "entropy source. The seed is read before `main` with GCC and Clang, and "
+    "on the first call to `hash_data` or `hash_combine` otherwise, so with "
+    "other compilers the first hash must not be made by two threads at "
+    "once. It can also be set "
+    "with `hash_seed`, but only before any hash is stored, including by the "
+    "runtime itself, since stored hashes are never recomputed."
+    "\n\n"
+    "Collections build their hash from those of their items with "
+    "`hash_combine`. Sequences such as `Array` and `Tuple` chain it so that "
+    "order matters, while tables sum the combined hash of each key and value "
+    "so that two tables with the same contents hash the same.";
 }
 
 static const char* Hash_Definition(void) {
@@ -40,15 +64,11 @@ static struct Example* Hash_Examples(void) {
       "println(\"%li\", $I(hash($I(  1)))); /*   1 */\n"
       "println(\"%li\", $I(hash($I(123)))); /* 123 */\n"
       "\n"
-      "/* 866003103 */\n"
-      "println(\"%li\", $I(hash_data($I(123), size(Int))));\n"
-      "\n"
-      "println(\"%li\", $I(hash($S(\"Hello\"))));  /* -1838682532 */\n"
-      "println(\"%li\", $I(hash($S(\"There\"))));  /*   961387266 */\n"
-      "println(\"%li\", $I(hash($S(\"People\")))); /*   697467069 */\n"
+      "println(\"%li\", $I(hash_data(\"Hello\", 5)));\n"
+      "println(\"%li\", $I(hash($S(\"Hello\"))));  /* Same as above */\n"
     }, {NULL, NULL}
   };
-
+  
   return examples;
   
 }
@@ -62,9 +82,21 @@ static struct Method* Hash_Methods(void) {
       "Get the hash value for the object `self`."
     }, {
       "hash_data", 
-      "uint64_t hash_data(void* data, size_t num);",
+      "uint64_t hash_data(const void* data, size_t num);",
       "Hash `num` bytes pointed to by `data` using "
-      "[Murmurhash](http://en.wikipedia.org/wiki/MurmurHash)."
+      "[wyhash](https://github.com/wangyi-fudan/wyhash)."
+    }, {
+      "hash_combine",
+      "uint64_t hash_combine(uint64_t h, uint64_t x);",
+      "Mix the hash `x` into the running hash `h`. This depends on the order "
+      "hashes are combined in, so it suits sequences. For unordered "
+      "collections the combined hash of each entry can be summed instead."
+    }, {
+      "hash_seed",
+      "void hash_seed(uint64_t seed);",
+      "Set the seed used by `hash_data` for the whole process. This must be "
+      "called before any hash is stored, such as from a constructor, and "
+      "throws a `ValueError` once any `Symbol` has been interned."
     }, {NULL, NULL, NULL}
   };
   
@@ -76,45 +108,233 @@ var Hash = Cello(Hash,
     Hash_Name,       Hash_Brief,    Hash_Description, 
     Hash_Definition, Hash_Examples, Hash_Methods));
     
-uint64_t hash_data(const void* data, size_t size) {
+/*
+**  This is wyhash (final version 4) by Wang Yi. Long inputs are consumed
+**  48 bytes at a time in three independent lanes, which keeps several
+**  multiplies in flight at once, and short inputs take a single multiply.
+**  The seed is mixed with the secret once in `hash_seed` rather than on
+**  every call.
+*/
+
+static const uint64_t Hash_Secret[4] = {
+  0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+  0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+/* The mixed form of the default seed `0xCe110` */
+static uint64_t Hash_Seed = 0xDC29C65195C54081ull;
+
+#if defined(__GNUC__)
+#define Hash_Seed_Check()
+#else
+static bool Hash_Seed_Ready = false;
+static void Hash_Seed_Init(void);
+#define Hash_Seed_Check() if (not Hash_Seed_Ready) { Hash_Seed_Init(); }
+#endif
+
+static void Hash_Mum(uint64_t* a, uint64_t* b) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = (__uint128_t)*a * *b;
+  *a = (uint64_t)r;
+  *b = (uint64_t)(r >> 64);
+#else
+  uint64_t ha = *a >> 32, hb = *b >> 32;
+  uint64_t la = (uint32_t)*a, lb = (uint32_t)*b;
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  uint64_t t = rl + (rm0 << 32), c = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  *a = lo;
+  *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static uint64_t Hash_Mix(uint64_t a, uint64_t b) {
+  Hash_Mum(&a, &b);
+  return a ^ b;
+}
+
+static uint64_t Hash_Read8(const uint8_t* p) {
+  uint64_t v;
+  memcpy(&v, p, 8);
+  return v;
+}
+
+static uint64_t Hash_Read4(const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, 4);
+  return v;
+}
+
+/*
+**  Eight bytes read as two four byte words, with the first word in the
+**  high half when `first` is set and in the low half otherwise.
+*/
+
+static uint64_t Hash_Read44(const uint8_t* p, bool first) {
+  uint64_t v = Hash_Read8(p);
+#if defined(__BYTE_ORDER__) and __BYTE_ORDER__ is __ORDER_BIG_ENDIAN__
+  first = not first;
+#endif
+  return first ? (v << 32) | (v >> 32) : v;
+}
+
+void hash_seed(uint64_t seed) {
   
-  const uint64_t m = 0xc6a4a7935bd1e995;
-	const int r = 47;
-	const uint64_t * d = (const uint64_t*)data;
-	const uint64_t * end = d + (size/8);
+  if (Cello_Interned()) {
+    throw(ValueError, "Cannot set hash seed after a Symbol is interned!");
+  }
   
-	uint64_t h = 0xCe110 ^ (size * m);
+#ifndef __GNUC__
+  Hash_Seed_Ready = true;
+#endif
+  Hash_Seed = seed ^ Hash_Mix(seed ^ Hash_Secret[0], Hash_Secret[1]);
+}
 
-	while (d != end) {
-		uint64_t k = *d++;
-		k *= m; 
-		k ^= k >> r; 
-		k *= m; 
-		h ^= k;
-		h *= m; 
-	}
+/*
+**  A `random` seed has to be unpredictable to stop hash flooding, so it is
+**  read from the operating system rather than made from the clock. If that
+**  fails there is no safe seed to fall back on.
+*/
+
+static uint64_t Hash_Seed_Random(void) {
+  
+  uint64_t seed = 0;
+  bool ok = false;
+  
+#if defined(CELLO_WINDOWS)
+  ok = BCRYPT_SUCCESS(BCryptGenRandom(NULL, (PUCHAR)&seed, sizeof(seed),
+    BCRYPT_USE_SYSTEM_PREFERRED_RNG));
+#else
+  FILE* f = fopen("/dev/urandom", "rb");
+  if (f isnt NULL) {
+    ok = fread(&seed, sizeof(seed), 1, f) is 1;
+    fclose(f);
+  }
+#endif
+  
+  if (not ok) {
+    fprintf(stderr, "Cello Fatal Error: Cannot read a random hash seed!\n");
+    abort();
+  }
+  
+  return seed;
+}
 
-	const unsigned char * data2 = (const unsigned char*)d;
+/*
+**  The runtime stores hashes of its own before `main` is reached, so the
+**  `CELLO_HASH_SEED` environment variable is read in a constructor where
+**  the compiler supports one, and otherwise just before the first hash.
+*/
 
-	switch (size & 7) {
-    case 7: h ^= (uint64_t)(data2[6]) << 48;
-    case 6: h ^= (uint64_t)(data2[5]) << 40;
-    case 5: h ^= (uint64_t)(data2[4]) << 32;
-    case 4: h ^= (uint64_t)(data2[3]) << 24;
-    case 3: h ^= (uint64_t)(data2[2]) << 16;
-    case 2: h ^= (uint64_t)(data2[1]) << 8;
-    case 1: h ^= (uint64_t)(data2[0]);
-            h *= m;
-	};
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void Hash_Seed_Init(void) {
   
-	h ^= h >> r;
-	h *= m;
-	h ^= h >> r;
+#ifndef __GNUC__
+  Hash_Seed_Ready = true;
+#endif
+  
+  const char* env = getenv("CELLO_HASH_SEED");
+  if (env is NULL) { return; }
+  
+  if (strcmp(env, "random") is 0) {
+    hash_seed(Hash_Seed_Random());
+  } else {
+    hash_seed(strtoull(env, NULL, 0));
+  }
+  
+}
 
-	return h;
+static uint64_t Hash_Finish(uint64_t a, uint64_t b, uint64_t seed, size_t n) {
+  a ^= Hash_Secret[1];
+  b ^= seed;
+  Hash_Mum(&a, &b);
+  return Hash_Mix(a ^ Hash_Secret[0] ^ n, b ^ Hash_Secret[1]);
+}
+
+/*
+**  Inputs over 16 bytes are hashed out of line so that the registers the
+**  bulk loop needs are not saved and restored on every call for short keys.
+*/
 
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+static uint64_t Hash_Long(const uint8_t* p, size_t size, uint64_t seed) {
+  
+  size_t i = size;
+  
+  if (i >= 48) {
+    uint64_t seed1 = seed, seed2 = seed;
+    do {
+      seed  = Hash_Mix(Hash_Read8(p+ 0) ^ Hash_Secret[1],
+                       Hash_Read8(p+ 8) ^ seed);
+      seed1 = Hash_Mix(Hash_Read8(p+16) ^ Hash_Secret[2],
+                       Hash_Read8(p+24) ^ seed1);
+      seed2 = Hash_Mix(Hash_Read8(p+32) ^ Hash_Secret[3],
+                       Hash_Read8(p+40) ^ seed2);
+      p += 48; i -= 48;
+    } while (i >= 48);
+    seed ^= seed1 ^ seed2;
+  }
+  
+  while (i > 16) {
+    seed = Hash_Mix(Hash_Read8(p) ^ Hash_Secret[1],
+                    Hash_Read8(p + 8) ^ seed);
+    p += 16; i -= 16;
+  }
+  
+  return Hash_Finish(
+    Hash_Read8(p + i - 16), Hash_Read8(p + i - 8), seed, size);
 }
-    
+
+/*
+**  For keys of 8 to 15 bytes, the usual length of a `String` key, the two
+**  pairs of words wyhash joins are adjacent, so each is read with a single
+**  load. This gives exactly the same hash as the four separate reads.
+*/
+
+uint64_t hash_data(const void* data, size_t size) {
+  
+  Hash_Seed_Check();
+  
+  const uint8_t* p = data;
+  
+  if (size > 16) {
+    return Hash_Long(p, size, Hash_Seed);
+  }
+  
+  if (size >= 8 and size < 16) {
+    return Hash_Finish(
+      Hash_Read44(p, true), Hash_Read44(p + size - 8, false),
+      Hash_Seed, size);
+  }
+  
+  if (size >= 4) {
+    size_t o = (size >> 3) << 2;
+    return Hash_Finish(
+      (Hash_Read4(p) << 32) | Hash_Read4(p + o),
+      (Hash_Read4(p + size - 4) << 32) | Hash_Read4(p + size - 4 - o),
+      Hash_Seed, size);
+  }
+  
+  if (size > 0) {
+    return Hash_Finish(
+      ((uint64_t)p[0] << 16) | ((uint64_t)p[size >> 1] << 8) | p[size-1],
+      0, Hash_Seed, size);
+  }
+  
+  return Hash_Finish(0, 0, Hash_Seed, 0);
+  
+}
+
+uint64_t hash_combine(uint64_t h, uint64_t x) {
+  Hash_Seed_Check();
+  return Hash_Mix(h ^ Hash_Seed, x ^ Hash_Secret[1]);
+}
+
 uint64_t hash(var self) {
   
   struct Hash* h = instance(self, Hash);
@@ -30,6 +30,7 @@ static const char* Iter_Definition(void) {
     "  var (*iter_prev)(var, var);\n"
     "  var (*iter_last)(var);\n"
     "  var (*iter_type)(var);\n"
+    "  var (*iter_val)(var, var);\n"
     "};\n";
 }
 
@@ -84,6 +85,12 @@ static struct Method* Iter_Methods(void) {
       "var iter_type(var self);",
       "Returns the type of item that can be expected to be returned by the "
       "iterable."
+    }, {
+      "iter_val", 
+      "var iter_val(var self, var curr);",
+      "Given the current key `curr` in the iteration over a map `self`, "
+      "return the value stored with it. Types without `iter_val` fall back to "
+      "`get(self, curr)`."
     }, {NULL, NULL, NULL}
   };
   
@@ -115,6 +122,14 @@ var iter_type(var self) {
   return method(self, Iter, iter_type);  
 }
 
+var iter_val(var self, var curr) {
+  struct Iter* i = instance(self, Iter);
+  if (i and i->iter_val) {
+    return i->iter_val(self, curr);
+  }
+  return get(self, curr);
+}
+
 static const char* Range_Name(void) {
   return "Range";
 }
@@ -305,7 +320,7 @@ static size_t Range_Len(var self) {
   return 0;
 }
 
-static var Range_Get(var self, var key) {
+static var Range_Try_Get(var self, var key) {
   struct Range* r = self;
   struct Int* x = r->value;
   
@@ -317,6 +332,8 @@ static var Range_Get(var self, var key) {
     return x;
   }
   
+  if (i < 0) { return NULL; }
+  
   if (r->step  > 0 and (r->start + r->step * i) < r->stop) {
     x->val = r->start  + r->step * i;
     return x;
@@ -327,9 +344,18 @@ static var Range_Get(var self, var key) {
     return x;
   }
   
-  return throw(IndexOutOfBoundsError, 
+  return NULL;
+}
+
+static var Range_Get(var self, var key) {
+  struct Range* r = self;
+  var val = Range_Try_Get(self, key);
+  if (val is NULL) {
+    return throw(IndexOutOfBoundsError, 
       "Index '%i' out of bounds for Range of start %i, stop %i and step %i.", 
       key, $I(r->start), $I(r->stop), $I(r->step));
+  }
+  return val;
 }
 
 static bool Range_Mem(var self, var key) {
@@ -366,7 +392,8 @@ var Range = Cello(Range,
   Instance(Assign,    Range_Assign),
   Instance(Cmp,       Range_Cmp),
   Instance(Len,       Range_Len),
-  Instance(Get,       Range_Get, NULL, Range_Mem, NULL),
+  Instance(Get,       
+    Range_Get, NULL, Range_Mem, NULL, NULL, NULL, Range_Try_Get),
   Instance(Show,      Range_Show, NULL),
   Instance(Iter, 
     Range_Iter_Init,  Range_Iter_Next, 
@@ -888,6 +915,152 @@ var enumerate_stack(var self) {
   return self;
 }
 
+static const char* Items_Name(void) {
+  return "Items";
+}
+
+static const char* Items_Brief(void) {
+  return "Key Value Iterator";
+}
+
+static const char* Items_Description(void) {
+  return
+    "The `Items` type iterates over a map such as a `Table` or `Tree` and "
+    "returns each key together with its value as a Tuple. The value is found "
+    "with `iter_val`, which for the built in maps finds it directly from the "
+    "key, so each step costs the same as iterating the keys alone rather "
+    "than a further `get`. Like `Zip` the same Tuple is reused for every "
+    "step, so its contents should be copied if they are to be kept.";
+}
+
+static const char* Items_Definition(void) {
+  return
+    "struct Items {\n"
+    "  var iter;\n"
+    "  var pair;\n"
+    "};\n";
+}
+
+static struct Example* Items_Examples(void) {
+  
+  static struct Example examples[] = {
+    {
+      "Usage",
+      "var prices = new(Tree, String, Int);\n"
+      "set(prices, $S(\"Apple\"),  $I(12));\n"
+      "set(prices, $S(\"Banana\"), $I( 6));\n"
+      "\n"
+      "foreach (pair in items(prices)) {\n"
+      "  print(\"Price of %$ is %$\\n\", get(pair, $I(0)), get(pair, $I(1)));\n"
+      "}\n"
+    }, {NULL, NULL}
+  };
+
+  return examples;
+  
+}
+
+static struct Method* Items_Methods(void) {
+  
+  static struct Method methods[] = {
+    {
+      "items", 
+      "#define items(I)",
+      "Construct an `Items` object on the stack over the map `I`."
+    }, {NULL, NULL, NULL}
+  };
+  
+  return methods;
+}
+
+var items_stack(var self) {
+  struct Items* it = self;
+  struct Tuple* t = it->pair;
+  t->items[0] = _;
+  t->items[1] = _;
+  t->items[2] = Terminal;
+  return it;
+}
+
+static void Items_New(var self, var args) {
+  struct Items* it = self;
+  it->iter = get(args, $I(0));
+  it->pair = new(Tuple, _, _);
+}
+
+static void Items_Del(var self) {
+  struct Items* it = self;
+  del(it->pair);
+}
+
+static void Items_Assign(var self, var obj) {
+  struct Items* it = self;
+  struct Items* o = cast(obj, Items);
+  it->iter = o->iter;
+  assign(it->pair, o->pair);
+}
+
+/*
+**  The `Iter` instance of the map is looked up once per step and used for
+**  both the key and the value, rather than dispatching through `iter_next`
+**  and `iter_val` separately.
+*/
+
+static var Items_Pair(struct Items* it, struct Iter* i, var key) {
+  if (key is Terminal) { return Terminal; }
+  struct Tuple* t = it->pair;
+  t->items[0] = key;
+  t->items[1] = i->iter_val ? i->iter_val(it->iter, key) : get(it->iter, key);
+  t->hash = 0;
+  return t;
+}
+
+static var Items_Iter_Init(var self) {
+  struct Items* it = self;
+  struct Iter* i = instance(it->iter, Iter);
+  return Items_Pair(it, i, iter_init(it->iter));
+}
+
+static var Items_Iter_Last(var self) {
+  struct Items* it = self;
+  struct Iter* i = instance(it->iter, Iter);
+  return Items_Pair(it, i, iter_last(it->iter));
+}
+
+static var Items_Iter_Next(var self, var curr) {
+  struct Items* it = self;
+  struct Iter* i = instance(it->iter, Iter);
+  struct Tuple* t = curr;
+  return Items_Pair(it, i, i->iter_next(it->iter, t->items[0]));
+}
+
+static var Items_Iter_Prev(var self, var curr) {
+  struct Items* it = self;
+  struct Iter* i = instance(it->iter, Iter);
+  struct Tuple* t = curr;
+  return Items_Pair(it, i, iter_prev(it->iter, t->items[0]));
+}
+
+static var Items_Iter_Type(var self) {
+  return Tuple;
+}
+
+static size_t Items_Len(var self) {
+  struct Items* it = self;
+  return len(it->iter);
+}
+
+var Items = Cello(Items,
+  Instance(Doc,
+    Items_Name,       Items_Brief,    Items_Description, 
+    Items_Definition, Items_Examples, Items_Methods),
+  Instance(New,       Items_New, Items_Del),
+  Instance(Assign,    Items_Assign),
+  Instance(Len,       Items_Len),
+  Instance(Iter, 
+    Items_Iter_Init,  Items_Iter_Next, 
+    Items_Iter_Last,  Items_Iter_Prev, Items_Iter_Type));
+
 static const char* Filter_Name(void) {
   return "Filter";
 }
@@ -223,7 +223,7 @@ static uint64_t List_Hash(var self) {
   
   var item = l->head;
   for (size_t i = 0; i < l->nitems; i++) {
-    h ^= hash(item);
+    h = hash_combine(h, hash(item));
     item = *List_Next(l, item);
   }
   
@@ -348,6 +348,14 @@ static var List_Get(var self, var key) {
   return List_At(l, c_int(key));
 }
 
+static var List_Try_Get(var self, var key) {
+  struct List* l = self;
+  int64_t i = c_int(key);
+  i = i < 0 ? l->nitems+i : i;
+  if (i < 0 or i >= (int64_t)l->nitems) { return NULL; }
+  return List_At(l, i);
+}
+
 static void List_Set(var self, var key, var val) {
   struct List* l = self;
   assign(List_At(l, c_int(key)), val);
@@ -441,7 +449,9 @@ var List = Cello(List,
     List_Push_At,   List_Pop_At),
   Instance(Concat,  List_Concat, List_Push),
   Instance(Len,     List_Len),
-  Instance(Get,     List_Get, List_Set, List_Mem, List_Rem),
+  Instance(Get,     
+    List_Get, List_Set, List_Mem, List_Rem, 
+    NULL, NULL, List_Try_Get),
   Instance(Iter,
     List_Iter_Init, List_Iter_Next,
     List_Iter_Last, List_Iter_Prev, List_Iter_Type),
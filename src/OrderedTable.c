@@ -0,0 +1,564 @@
+#include "Cello.h"
+
+static const char* OrderedTable_Name(void) {
+  return "OrderedTable";
+}
+
+static const char* OrderedTable_Brief(void) {
+  return "Insertion ordered hash table";
+}
+
+static const char* OrderedTable_Description(void) {
+  return
+    "The `OrderedTable` type is a hash table data structure that maps keys "
+    "to values and remembers the order in which keys were first inserted. It "
+    "has the same interface as `Table` and also requires `Hash` and `Cmp` to "
+    "be defined on the key type."
+    "\n\n"
+    "Entries are appended to a dense array in insertion order, and a "
+    "separate sparse index of entry numbers is used to find them by hash. "
+    "Iteration walks the dense array, so it costs `O(n)` in the number of "
+    "items rather than in the capacity of the table, and it always visits "
+    "keys in insertion order. Setting an existing key keeps its position."
+    "\n\n"
+    "Removing a key leaves a hole in the dense array. Once more than half of "
+    "the entries are holes the table is compacted, which also shrinks it."
+    "\n\n"
+    "This is largely equivalent to the Python "
+    "[dict](https://docs.python.org/3/library/stdtypes.html#dict) type.";
+}
+
+static struct Example* OrderedTable_Examples(void) {
+  
+  static struct Example examples[] = {
+    {
+      "Usage",
+      "var prices = new(OrderedTable, String, Int);\n"
+      "set(prices, $S(\"Pear\"),   $I(55));\n"
+      "set(prices, $S(\"Apple\"),  $I(12));\n"
+      "set(prices, $S(\"Banana\"), $I( 6));\n"
+      "\n"
+      "/* Pear, Apple, Banana */\n"
+      "foreach (key in prices) {\n"
+      "  var price = get(prices, key);\n"
+      "  println(\"Price of %$ is %$\", key, price);\n"
+      "}\n"
+    }, {NULL, NULL}
+  };
+  
+  return examples;
+  
+}
+
+struct OrderedTable {
+  var ktype;
+  var vtype;
+  size_t ksize;
+  size_t vsize;
+  size_t* index;
+  size_t nindex;
+  size_t nshift;
+  var entries;
+  size_t nentries;
+  size_t mentries;
+  size_t nitems;
+};
+
+enum {
+  ORDEREDTABLE_EMPTY   = 0,
+  ORDEREDTABLE_DELETED = 1,
+  ORDEREDTABLE_OFFSET  = 2,
+  ORDEREDTABLE_MIN     = 8
+};
+
+static size_t OrderedTable_Size_Round(size_t s) {
+  return ((s + sizeof(var) - 1) / sizeof(var)) * sizeof(var);
+}
+
+static size_t OrderedTable_Usable(size_t nindex) {
+  return (nindex * 2) / 3;
+}
+
+static size_t OrderedTable_Ideal_Size(size_t size) {
+  size_t n = ORDEREDTABLE_MIN;
+  while (OrderedTable_Usable(n) < size) { n = n * 2; }
+  return n;
+}
+
+static size_t OrderedTable_Step(struct OrderedTable* t) {
+  return
+    sizeof(uint64_t) +
+    sizeof(struct Header) + t->ksize +
+    sizeof(struct Header) + t->vsize;
+}
+
+static uint64_t OrderedTable_Entry_Hash(struct OrderedTable* t, size_t e) {
+  return *(uint64_t*)((char*)t->entries + e * OrderedTable_Step(t));
+}
+
+static var OrderedTable_Key(struct OrderedTable* t, size_t e) {
+  return (char*)t->entries + e * OrderedTable_Step(t) +
+    sizeof(uint64_t) +
+    sizeof(struct Header);
+}
+
+static var OrderedTable_Val(struct OrderedTable* t, size_t e) {
+  return (char*)t->entries + e * OrderedTable_Step(t) +
+    sizeof(uint64_t) +
+    sizeof(struct Header) +
+    t->ksize +
+    sizeof(struct Header);
+}
+
+static size_t OrderedTable_Entry(struct OrderedTable* t, var key) {
+  return ((char*)key - (char*)t->entries) / OrderedTable_Step(t);
+}
+
+static uint64_t OrderedTable_Hash_Of(var key) {
+  uint64_t h = hash(key);
+  return h is 0 ? 1 : h;
+}
+
+static size_t OrderedTable_Home(struct OrderedTable* t, uint64_t h) {
+  return (h * 0x9E3779B97F4A7C15ull) >> t->nshift;
+}
+
+static bool OrderedTable_Find(struct OrderedTable* t,
+  var key, uint64_t h, size_t* pi) {
+  
+  size_t mask = t->nindex-1;
+  size_t i = OrderedTable_Home(t, h);
+  
+  while (true) {
+    
+    size_t x = t->index[i];
+    if (x is ORDEREDTABLE_EMPTY) { return false; }
+    
+    if (x isnt ORDEREDTABLE_DELETED) {
+      size_t e = x - ORDEREDTABLE_OFFSET;
+      if (OrderedTable_Entry_Hash(t, e) is h
+      and eq(OrderedTable_Key(t, e), key)) {
+        *pi = i;
+        return true;
+      }
+    }
+    
+    i = (i+1) & mask;
+  }
+  
+  return false;
+}
+
+static void OrderedTable_Place(struct OrderedTable* t, uint64_t h, size_t e) {
+  size_t mask = t->nindex-1;
+  size_t i = OrderedTable_Home(t, h);
+  while (t->index[i] > ORDEREDTABLE_DELETED) { i = (i+1) & mask; }
+  t->index[i] = e + ORDEREDTABLE_OFFSET;
+}
+
+/* Returns the old entries so they can be freed once the caller is done */
+static var OrderedTable_Rebuild_Keep(struct OrderedTable* t, size_t nindex) {
+  
+  size_t* old_index = t->index;
+  var old_entries = t->entries;
+  size_t old_nentries = t->nentries;
+  
+  t->nindex = nindex;
+  t->nshift = 64;
+  while (nindex > 1) { nindex = nindex / 2; t->nshift--; }
+  
+  t->mentries = OrderedTable_Usable(t->nindex);
+  t->index = calloc(t->nindex, sizeof(size_t));
+  t->entries = malloc(t->mentries * OrderedTable_Step(t));
+  
+#if CELLO_MEMORY_CHECK == 1
+  if (t->index is NULL or t->entries is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate OrderedTable, out of memory!");
+  }
+#endif
+  
+  t->nentries = 0;
+  
+  for (size_t e = 0; e < old_nentries; e++) {
+    
+    char* entry = (char*)old_entries + e * OrderedTable_Step(t);
+    uint64_t h = *(uint64_t*)entry;
+    if (h is 0) { continue; }
+    
+    memcpy((char*)t->entries + t->nentries * OrderedTable_Step(t),
+      entry, OrderedTable_Step(t));
+    OrderedTable_Place(t, h, t->nentries);
+    t->nentries++;
+  }
+  
+  free(old_index);
+  return old_entries;
+}
+
+static void OrderedTable_Rebuild(struct OrderedTable* t, size_t nindex) {
+  free(OrderedTable_Rebuild_Keep(t, nindex));
+}
+
+static var OrderedTable_Upsert(struct OrderedTable* t,
+  var key, var val, bool* found) {
+  
+  uint64_t h = OrderedTable_Hash_Of(key);
+  size_t i;
+  
+  if (t->nindex isnt 0 and OrderedTable_Find(t, key, h, &i)) {
+    *found = true;
+    return OrderedTable_Val(t, t->index[i] - ORDEREDTABLE_OFFSET);
+  }
+  
+  /* Old entries are kept until the insert as key or val may point into them */
+  var old_entries = NULL;
+  if (t->nentries is t->mentries) {
+    old_entries = OrderedTable_Rebuild_Keep(t,
+      OrderedTable_Ideal_Size(2 * (t->nitems+1)));
+  }
+  
+  size_t e = t->nentries;
+  char* entry = (char*)t->entries + e * OrderedTable_Step(t);
+  memset(entry, 0, OrderedTable_Step(t));
+  memcpy(entry, &h, sizeof(uint64_t));
+  header_init((struct Header*)(entry + sizeof(uint64_t)),
+    t->ktype, AllocData);
+  header_init((struct Header*)(entry + sizeof(uint64_t) +
+    sizeof(struct Header) + t->ksize), t->vtype, AllocData);
+  assign(OrderedTable_Key(t, e), key);
+  assign(OrderedTable_Val(t, e), val);
+  
+  OrderedTable_Place(t, h, e);
+  t->nentries++;
+  t->nitems++;
+  
+  free(old_entries);
+  
+  *found = false;
+  return OrderedTable_Val(t, e);
+}
+
+static void OrderedTable_Set(var self, var key, var val) {
+  struct OrderedTable* t = self;
+  key = cast(key, t->ktype);
+  val = cast(val, t->vtype);
+  
+  bool found;
+  var curr = OrderedTable_Upsert(t, key, val, &found);
+  if (found) { assign(curr, val); }
+}
+
+static void OrderedTable_Clear(struct OrderedTable* t) {
+  
+  for (size_t e = 0; e < t->nentries; e++) {
+    if (OrderedTable_Entry_Hash(t, e) isnt 0) {
+      destruct(OrderedTable_Key(t, e));
+      destruct(OrderedTable_Val(t, e));
+    }
+  }
+  
+  free(t->index);
+  free(t->entries);
+  
+  t->index = NULL;
+  t->entries = NULL;
+  t->nindex = 0;
+  t->nshift = 64;
+  t->nentries = 0;
+  t->mentries = 0;
+  t->nitems = 0;
+}
+
+static void OrderedTable_New(var self, var args) {
+  
+  struct OrderedTable* t = self;
+  t->ktype = cast(get(args, $(Int, 0)), Type);
+  t->vtype = cast(get(args, $(Int, 1)), Type);
+  t->ksize = OrderedTable_Size_Round(size(t->ktype));
+  t->vsize = OrderedTable_Size_Round(size(t->vtype));
+  t->index = NULL;
+  t->entries = NULL;
+  t->nindex = 0;
+  t->nshift = 64;
+  t->nentries = 0;
+  t->mentries = 0;
+  t->nitems = 0;
+  
+  size_t nargs = len(args);
+  if (nargs % 2 isnt 0) {
+    throw(FormatError,
+      "Received non multiple of two argument count to "
+      "OrderedTable constructor.");
+  }
+  
+  if ((nargs-2)/2 > 0) {
+    OrderedTable_Rebuild(t, OrderedTable_Ideal_Size((nargs-2)/2));
+  }
+  
+  for(size_t i = 0; i < (nargs-2)/2; i++) {
+    var key = get(args, $(Int, 2+(i*2)+0));
+    var val = get(args, $(Int, 2+(i*2)+1));
+    OrderedTable_Set(t, key, val);
+  }
+  
+}
+
+static void OrderedTable_Del(var self) {
+  OrderedTable_Clear(self);
+}
+
+static var OrderedTable_Key_Type(var self) {
+  struct OrderedTable* t = self;
+  return t->ktype;
+}
+
+static var OrderedTable_Val_Type(var self) {
+  struct OrderedTable* t = self;
+  return t->vtype;
+}
+
+static void OrderedTable_Assign(var self, var obj) {
+  struct OrderedTable* t = self;
+  OrderedTable_Clear(t);
+  
+  t->ktype = implements_method(obj, Get, key_type) ? key_type(obj) : Ref;
+  t->vtype = implements_method(obj, Get, val_type) ? val_type(obj) : Ref;
+  t->ksize = OrderedTable_Size_Round(size(t->ktype));
+  t->vsize = OrderedTable_Size_Round(size(t->vtype));
+  
+  size_t n = len(obj);
+  if (n > 0) { OrderedTable_Rebuild(t, OrderedTable_Ideal_Size(n)); }
+  
+  foreach(key in obj) {
+    OrderedTable_Set(t, key, get(obj, key));
+  }
+  
+}
+
+static var OrderedTable_Try_Get(var self, var key) {
+  struct OrderedTable* t = self;
+  
+  if (key >= t->entries and ((char*)key) <
+    ((char*)t->entries) + t->nentries * OrderedTable_Step(t)) {
+    return OrderedTable_Val(t, OrderedTable_Entry(t, key));
+  }
+  
+  key = cast(key, t->ktype);
+  
+  if (t->nindex is 0) { return NULL; }
+  
+  size_t i;
+  if (not OrderedTable_Find(t, key, OrderedTable_Hash_Of(key), &i)) {
+    return NULL;
+  }
+  return OrderedTable_Val(t, t->index[i] - ORDEREDTABLE_OFFSET);
+}
+
+static var OrderedTable_Get(var self, var key) {
+  var val = OrderedTable_Try_Get(self, key);
+  if (val is NULL) {
+    return throw(KeyError, "Key %$ not in OrderedTable!", key);
+  }
+  return val;
+}
+
+static var OrderedTable_Get_Or_Insert(var self, var key, var val) {
+  struct OrderedTable* t = self;
+  bool found;
+  return OrderedTable_Upsert(t,
+    cast(key, t->ktype), cast(val, t->vtype), &found);
+}
+
+static bool OrderedTable_Mem(var self, var key) {
+  struct OrderedTable* t = self;
+  key = cast(key, t->ktype);
+  
+  if (t->nindex is 0) { return false; }
+  
+  size_t i;
+  return OrderedTable_Find(t, key, OrderedTable_Hash_Of(key), &i);
+}
+
+static void OrderedTable_Rem(var self, var key) {
+  struct OrderedTable* t = self;
+  key = cast(key, t->ktype);
+  
+  size_t i;
+  if (t->nindex is 0
+  or  not OrderedTable_Find(t, key, OrderedTable_Hash_Of(key), &i)) {
+    throw(KeyError, "Key %$ not in OrderedTable!", key);
+  }
+  
+  size_t e = t->index[i] - ORDEREDTABLE_OFFSET;
+  destruct(OrderedTable_Key(t, e));
+  destruct(OrderedTable_Val(t, e));
+  memset((char*)t->entries + e * OrderedTable_Step(t), 0, sizeof(uint64_t));
+  t->index[i] = ORDEREDTABLE_DELETED;
+  t->nitems--;
+  
+  if (t->nitems is 0) {
+    OrderedTable_Clear(t);
+  } else if (t->nitems * 2 < t->nentries) {
+    OrderedTable_Rebuild(t, OrderedTable_Ideal_Size(2 * t->nitems));
+  }
+}
+
+static size_t OrderedTable_Len(var self) {
+  struct OrderedTable* t = self;
+  return t->nitems;
+}
+
+static var OrderedTable_Iter_From(struct OrderedTable* t, size_t e) {
+  for (; e < t->nentries; e++) {
+    if (OrderedTable_Entry_Hash(t, e) isnt 0) {
+      return OrderedTable_Key(t, e);
+    }
+  }
+  return Terminal;
+}
+
+static var OrderedTable_Iter_Init(var self) {
+  struct OrderedTable* t = self;
+  return OrderedTable_Iter_From(t, 0);
+}
+
+static var OrderedTable_Iter_Next(var self, var curr) {
+  struct OrderedTable* t = self;
+  return OrderedTable_Iter_From(t, OrderedTable_Entry(t, curr) + 1);
+}
+
+static var OrderedTable_Iter_Before(struct OrderedTable* t, size_t e) {
+  while (e > 0) {
+    e--;
+    if (OrderedTable_Entry_Hash(t, e) isnt 0) {
+      return OrderedTable_Key(t, e);
+    }
+  }
+  return Terminal;
+}
+
+static var OrderedTable_Iter_Last(var self) {
+  struct OrderedTable* t = self;
+  return OrderedTable_Iter_Before(t, t->nentries);
+}
+
+static var OrderedTable_Iter_Prev(var self, var curr) {
+  struct OrderedTable* t = self;
+  return OrderedTable_Iter_Before(t, OrderedTable_Entry(t, curr));
+}
+
+static var OrderedTable_Iter_Type(var self) {
+  struct OrderedTable* t = self;
+  return t->ktype;
+}
+
+static var OrderedTable_Iter_Val(var self, var curr) {
+  struct OrderedTable* t = self;
+  return OrderedTable_Val(t, OrderedTable_Entry(t, curr));
+}
+
+static int OrderedTable_Cmp(var self, var obj) {
+  
+  int c;
+  var item0 = OrderedTable_Iter_Init(self);
+  var item1 = iter_init(obj);
+  
+  while (true) {
+    if (item0 is Terminal and item1 is Terminal) { return 0; }
+    if (item0 is Terminal) { return -1; }
+    if (item1 is Terminal) { return  1; }
+    c = cmp(item0, item1);
+    if (c < 0) { return -1; }
+    if (c > 0) { return  1; }
+    c = cmp(OrderedTable_Iter_Val(self, item0), iter_val(obj, item1));
+    if (c < 0) { return -1; }
+    if (c > 0) { return  1; }
+    item0 = OrderedTable_Iter_Next(self, item0);
+    item1 = iter_next(obj, item1);
+  }
+  
+  return 0;
+  
+}
+
+static uint64_t OrderedTable_Hash(var self) {
+  struct OrderedTable* t = self;
+  uint64_t h = 0;
+  
+  for (size_t e = 0; e < t->nentries; e++) {
+    if (OrderedTable_Entry_Hash(t, e) isnt 0) {
+      h += hash_combine(
+        hash(OrderedTable_Key(t, e)), hash(OrderedTable_Val(t, e)));
+    }
+  }
+  
+  return h;
+}
+
+static int OrderedTable_Show(var self, var output, int pos) {
+  struct OrderedTable* t = self;
+  
+  pos = print_to(output, pos, "<'OrderedTable' At 0x%p {", self);
+  
+  size_t j = 0;
+  for (size_t e = 0; e < t->nentries; e++) {
+    if (OrderedTable_Entry_Hash(t, e) isnt 0) {
+      pos = print_to(output, pos, "%$:%$",
+        OrderedTable_Key(t, e), OrderedTable_Val(t, e));
+      if (j < t->nitems-1) { pos = print_to(output, pos, ", "); }
+      j++;
+    }
+  }
+  
+  return print_to(output, pos, "}>");
+}
+
+static void OrderedTable_Resize(var self, size_t n) {
+  struct OrderedTable* t = self;
+  
+  if (n is 0) {
+    OrderedTable_Clear(t);
+    return;
+  }
+  
+#if CELLO_BOUND_CHECK == 1
+  if (n < t->nitems) {
+    throw(FormatError,
+      "Cannot resize OrderedTable to make it smaller than %li items",
+      $I(t->nitems));
+  }
+#endif
+  
+  OrderedTable_Rebuild(t, OrderedTable_Ideal_Size(n));
+}
+
+static void OrderedTable_Mark(var self, var gc, void(*f)(var,void*)) {
+  struct OrderedTable* t = self;
+  for (size_t e = 0; e < t->nentries; e++) {
+    if (OrderedTable_Entry_Hash(t, e) isnt 0) {
+      f(gc, OrderedTable_Key(t, e));
+      f(gc, OrderedTable_Val(t, e));
+    }
+  }
+}
+
+var OrderedTable = Cello(OrderedTable,
+  Instance(Doc,
+    OrderedTable_Name, OrderedTable_Brief,    OrderedTable_Description,
+    NULL,              OrderedTable_Examples, NULL),
+  Instance(New,      OrderedTable_New, OrderedTable_Del),
+  Instance(Assign,   OrderedTable_Assign),
+  Instance(Mark,     OrderedTable_Mark),
+  Instance(Cmp,      OrderedTable_Cmp),
+  Instance(Hash,     OrderedTable_Hash),
+  Instance(Len,      OrderedTable_Len),
+  Instance(Get,
+    OrderedTable_Get, OrderedTable_Set, OrderedTable_Mem, OrderedTable_Rem,
+    OrderedTable_Key_Type, OrderedTable_Val_Type,
+    OrderedTable_Try_Get, OrderedTable_Get_Or_Insert),
+  Instance(Iter,
+    OrderedTable_Iter_Init, OrderedTable_Iter_Next,
+    OrderedTable_Iter_Last, OrderedTable_Iter_Prev, OrderedTable_Iter_Type,
+    OrderedTable_Iter_Val),
+  Instance(Show,     OrderedTable_Show, NULL),
+  Instance(Resize,   OrderedTable_Resize));
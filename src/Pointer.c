@@ -175,7 +175,16 @@ static const char* Box_Description(void) {
     "\n\n"
     "While this might not seem that useful when there is Garbage Collection "
     "this can be very useful when Garbage Collection is turned off, and when "
-    "used in conjunction with collections.";
+    "used in conjunction with collections."
+    "\n\n"
+    "When compiled with `CELLO_RC` a `Box` holds a counted reference. `new` "
+    "adopts the reference it is given, while assigning or copying a `Box`, "
+    "such as when it is pushed into a collection, retains a new one and "
+    "releases the one it held before. Creating a `Box` from another `Box` "
+    "shares its object and so also retains a new reference. The "
+    "object pointed to is freed when the last `Box` pointing to it is "
+    "deleted or removed from its collection. A `Ref` never holds a "
+    "reference.";
 }
 
 static const char* Box_Definition(void) {
@@ -231,7 +240,12 @@ static var Box_Deref(var self);
 static void Box_Assign(var self, var obj);
 
 static void Box_New(var self, var args) {
-  Box_Assign(self, get(args, $I(0)));
+  var obj = get(args, $I(0));
+  Box_Assign(self, obj);
+#ifdef CELLO_RC
+  /* A new Box adopts the reference it is given unless it is another Box */
+  if (type_of(obj) isnt Box) { release(Box_Deref(self)); }
+#endif
 }
 
 static void Box_Del(var self) {
@@ -242,11 +256,13 @@ static void Box_Del(var self) {
 
 static void Box_Assign(var self, var obj) {
   struct Pointer* p = instance(obj, Pointer);
-  if (p and p->deref) {
-    Box_Ref(self, p->deref(obj));
-  } else {
-    Box_Ref(self, obj);
-  }
+  var val = p and p->deref ? p->deref(obj) : obj;
+#ifdef CELLO_RC
+  /* Retain first in case the Box already points to `val` */
+  retain(val);
+  release(Box_Deref(self));
+#endif
+  Box_Ref(self, val);
 }
 
 static int Box_Show(var self, var output, int pos) {
@@ -271,3 +287,90 @@ var Box = Cello(Box,
   Instance(Show,     Box_Show, NULL),
   Instance(Pointer,  Box_Ref, Box_Deref));
   
+
+static const char* WeakRef_Name(void) {
+  return "WeakRef";
+}
+
+static const char* WeakRef_Brief(void) {
+  return "Weak Pointer";
+}
+
+static const char* WeakRef_Description(void) {
+  return
+    "The `WeakRef` type is a wrapper around a C pointer which does not keep "
+    "the object it points to alive. When the Garbage Collector finds that "
+    "the object pointed to is unreachable it sets the `WeakRef` to `NULL` "
+    "before any object is destructed, so a `WeakRef` never points to freed "
+    "memory as a result of collection."
+    "\n\n"
+    "Only `WeakRef` objects which are on the heap, or stored inside a "
+    "collection, are understood by the Garbage Collector. Those allocated on "
+    "the stack are scanned like any other stack memory and so keep the object "
+    "alive. Objects deleted manually using `del` are not tracked, so a "
+    "`WeakRef` should only be used to point to objects which are left to the "
+    "Garbage Collector.";
+}
+
+static const char* WeakRef_Definition(void) {
+  return
+    "struct WeakRef {\n"
+    "  var val;\n"
+    "};\n";
+}
+
+static struct Example* WeakRef_Examples(void) {
+  
+  static struct Example examples[] = {
+    {
+      "Usage",
+      "var w = new(WeakRef, new(String, $S(\"Hello\")));\n"
+      "if (deref(w)) {\n"
+      "  show(deref(w)); /* Hello, unless it has been collected */\n"
+      "}\n"
+    }, {
+      "Collections",
+      "var cache = new(Table, String, WeakRef);\n"
+      "set(cache, $S(\"key\"), $(WeakRef, new(Int, $I(1))));\n"
+      "/* The Int is not kept alive by the Table */\n"
+    }, {NULL, NULL}
+  };
+
+  return examples;
+  
+}
+
+static void WeakRef_Ref(var self, var val) {
+  struct WeakRef* w = self;
+  w->val = val;
+}
+
+static var WeakRef_Deref(var self) {
+  struct WeakRef* w = self;
+  return w->val;
+}
+
+static void WeakRef_Assign(var self, var obj) {
+  struct Pointer* p = instance(obj, Pointer);
+  if (p and p->deref) {
+    WeakRef_Ref(self, p->deref(obj));
+  } else {
+    WeakRef_Ref(self, obj);
+  }
+}
+
+static int WeakRef_Show(var self, var output, int pos) {
+  var val = WeakRef_Deref(self);
+  if (val is NULL) {
+    return print_to(output, pos, "<'WeakRef' at 0x%p (NULL)>", self);
+  }
+  return print_to(output, pos, "<'WeakRef' at 0x%p (%$)>", self, val);
+}
+
+var WeakRef = Cello(WeakRef,
+  Instance(Doc,
+    WeakRef_Name,       WeakRef_Brief,    WeakRef_Description, 
+    WeakRef_Definition, WeakRef_Examples, NULL),
+  Instance(Assign,   WeakRef_Assign),
+  Instance(Show,     WeakRef_Show, NULL),
+  Instance(Pointer,  WeakRef_Ref, WeakRef_Deref));
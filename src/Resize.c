@@ -15,13 +15,23 @@ static const char* Resize_Description(void) {
     "resource or other to be preallocated or reserved. For example this class "
     "is implemented by `Array` and `Table` to either remove a number of items "
     "quickly or to preallocate memory space if it is known that many items are "
-    "going to be added at a later date.";
+    "going to be added at a later date."
+    "\n\n"
+    "Unlike `resize`, `reserve` only ever grows the space held by an object "
+    "and `shrink_to_fit` only ever releases space it is not using. Objects "
+    "which do not implement them ignore these calls. The `load_factors` "
+    "method sets how full a container may become before growing and how "
+    "empty before shrinking. A minimum load of zero disables automatic "
+    "shrinking, which suits long lived tables with a steady size.";
 }
 
 static const char* Resize_Definition(void) {
   return
     "struct Resize {\n"
     "  void (*resize)(var, size_t);\n"
+    "  void (*reserve)(var, size_t);\n"
+    "  void (*shrink_to_fit)(var);\n"
+    "  void (*load_factors)(var, double, double);\n"
     "};\n";
 }
 
@@ -33,6 +43,19 @@ static struct Method* Resize_Methods(void) {
       "void resize(var self, size_t n);",
       "Resize to some size `n`, perhaps reserving some resource for object "
       "`self`."
+    }, {
+      "reserve", 
+      "void reserve(var self, size_t n);",
+      "Reserve space for at least `n` items in object `self`. Never shrinks."
+    }, {
+      "shrink_to_fit", 
+      "void shrink_to_fit(var self);",
+      "Release any space object `self` holds beyond what its items need."
+    }, {
+      "load_factors", 
+      "void load_factors(var self, double min_load, double max_load);",
+      "Set the fraction of its capacity object `self` may fill before "
+      "growing, `max_load`, and below which it shrinks, `min_load`."
     }, {NULL, NULL, NULL}
   };
   
@@ -53,6 +76,15 @@ static struct Example* Resize_Examples(void) {
       "Usage 2",
       "var x = new(Array, Int, $I(0), $I(1), $I(2));\n"
       "resize(x, 0); /* Clear Array of items */\n"
+    }, {
+      "Capacity",
+      "var t = new(Table, Int, Int);\n"
+      "reserve(t, 10000);         /* Grow once up front */\n"
+      "load_factors(t, 0.0, 0.9); /* Never shrink automatically */\n"
+      "\n"
+      "/* ... */\n"
+      "\n"
+      "shrink_to_fit(t);          /* Release unused slots */\n"
     }, {NULL, NULL}
   };
 
@@ -69,3 +101,18 @@ void resize(var self, size_t n) {
   method(self, Resize, resize, n);
 }
 
+void reserve(var self, size_t n) {
+  if (implements_method(self, Resize, reserve)) {
+    method(self, Resize, reserve, n);
+  }
+}
+
+void shrink_to_fit(var self) {
+  if (implements_method(self, Resize, shrink_to_fit)) {
+    method(self, Resize, shrink_to_fit);
+  }
+}
+
+void load_factors(var self, double min_load, double max_load) {
+  method(self, Resize, load_factors, min_load, max_load);
+}
@@ -0,0 +1,290 @@
+#include "Cello.h"
+
+static const char* Symbol_Name(void) {
+  return "Symbol";
+}
+
+static const char* Symbol_Brief(void) {
+  return "Interned String";
+}
+
+static const char* Symbol_Description(void) {
+  return
+    "The `Symbol` type is an immutable string which is stored exactly once in "
+    "a global pool. Two symbols with the same contents always point to the "
+    "same memory, so comparing them is a single pointer comparison, and "
+    "their hash is computed once when they are first interned."
+    "\n\n"
+    "This makes `Symbol` a good key type for a `Table` or `Tree` where keys "
+    "come from a small vocabulary, such as field names or tags. Lookups then "
+    "cost about the same as with `Int` keys, without the `strlen`, hashing "
+    "and `strcmp` a `String` key requires."
+    "\n\n"
+    "Symbols are created with `intern` or `new(Symbol, ...)` from anything "
+    "with a `C_Str`. They are ordered alphabetically like `String`, and "
+    "compare to a `String` the same way, but equal symbols are found equal "
+    "without reading their characters. The pool is safe to use from many "
+    "threads and its contents live until the program exits. As the pool "
+    "keeps the hash of every symbol, `hash_seed` throws a `ValueError` once "
+    "any symbol has been interned.";
+}
+
+static const char* Symbol_Definition(void) {
+  return
+    "struct Symbol {\n"
+    "  char* val;\n"
+    "  uint64_t hash;\n"
+    "};\n";
+}
+
+static struct Example* Symbol_Examples(void) {
+  
+  static struct Example examples[] = {
+    {
+      "Usage",
+      "var x = intern($S(\"Hello\"));\n"
+      "var y = intern($S(\"Hello\"));\n"
+      "show($I(x is y)); /* 1 */\n"
+      "show($I(eq(x, $S(\"Hello\")))); /* 1 */\n"
+    }, {
+      "Keys",
+      "var t = new(Table, Symbol, Int);\n"
+      "set(t, intern($S(\"width\")), $I(640));\n"
+      "set(t, intern($S(\"height\")), $I(480));\n"
+      "show(get(t, intern($S(\"width\")))); /* 640 */\n"
+    }, {NULL, NULL}
+  };
+  
+  return examples;
+  
+}
+
+static struct Method* Symbol_Methods(void) {
+  
+  static struct Method methods[] = {
+    {
+      "intern",
+      "var intern(var self);",
+      "Returns the unique `Symbol` with the same contents as the `C_Str` "
+      "`self`, adding it to the global pool if it is not already there."
+    }, {NULL, NULL, NULL}
+  };
+  
+  return methods;
+}
+
+/*
+**  Each interned symbol is a single allocation holding its object header,
+**  the `Symbol` itself and then its characters. Copies share its `val`
+**  pointer and `hash`, so the unique object is found again by probing the
+**  pool for that pointer without reading the characters.
+**
+**  The pool is an open addressed table of these objects behind one lock.
+**  Nothing inside the lock can reach a GC safepoint, so the lock is taken
+**  without entering a safe region.
+*/
+
+static var* Symbol_Pool = NULL;
+static size_t Symbol_Pool_Items = 0;
+static size_t Symbol_Pool_Slots = 0;
+
+#if defined(CELLO_UNIX)
+
+static pthread_mutex_t Symbol_Pool_Mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void Symbol_Pool_Lock(void) {
+  pthread_mutex_lock(&Symbol_Pool_Mutex);
+}
+
+static void Symbol_Pool_Unlock(void) {
+  pthread_mutex_unlock(&Symbol_Pool_Mutex);
+}
+
+#elif defined(CELLO_WINDOWS)
+
+static SRWLOCK Symbol_Pool_Mutex = SRWLOCK_INIT;
+
+static void Symbol_Pool_Lock(void) {
+  AcquireSRWLockExclusive(&Symbol_Pool_Mutex);
+}
+
+static void Symbol_Pool_Unlock(void) {
+  ReleaseSRWLockExclusive(&Symbol_Pool_Mutex);
+}
+
+#else
+
+static void Symbol_Pool_Lock(void) {}
+static void Symbol_Pool_Unlock(void) {}
+
+#endif
+
+static void Symbol_Pool_Del(void) {
+  for (size_t i = 0; i < Symbol_Pool_Slots; i++) {
+    if (Symbol_Pool[i] isnt NULL) { free(header(Symbol_Pool[i])); }
+  }
+  free(Symbol_Pool);
+  Symbol_Pool = NULL;
+  Symbol_Pool_Items = 0;
+  Symbol_Pool_Slots = 0;
+}
+
+static bool Symbol_Pool_Grow(void) {
+  
+  size_t nslots = Symbol_Pool_Slots is 0 ? 64 : Symbol_Pool_Slots * 2;
+  var* pool = calloc(nslots, sizeof(var));
+  if (pool is NULL) { return false; }
+  
+  for (size_t i = 0; i < Symbol_Pool_Slots; i++) {
+    struct Symbol* s = Symbol_Pool[i];
+    if (s is NULL) { continue; }
+    size_t j = s->hash & (nslots - 1);
+    while (pool[j] isnt NULL) { j = (j + 1) & (nslots - 1); }
+    pool[j] = s;
+  }
+  
+  if (Symbol_Pool is NULL) { atexit(Symbol_Pool_Del); }
+  
+  free(Symbol_Pool);
+  Symbol_Pool = pool;
+  Symbol_Pool_Slots = nslots;
+  return true;
+}
+
+static var Symbol_Intern(const char* val) {
+  
+  size_t n = strlen(val);
+  uint64_t h = hash_data(val, n);
+  
+  Symbol_Pool_Lock();
+  
+  if ((Symbol_Pool_Items + 1) * 2 > Symbol_Pool_Slots
+  and not Symbol_Pool_Grow()) {
+    Symbol_Pool_Unlock();
+    return throw(OutOfMemoryError, "Cannot intern Symbol, out of memory!");
+  }
+  
+  size_t i = h & (Symbol_Pool_Slots - 1);
+  while (Symbol_Pool[i] isnt NULL) {
+    struct Symbol* s = Symbol_Pool[i];
+    if (s->hash is h and strcmp(s->val, val) is 0) {
+      Symbol_Pool_Unlock();
+      return s;
+    }
+    i = (i + 1) & (Symbol_Pool_Slots - 1);
+  }
+  
+  char* head = malloc(sizeof(struct Header) + sizeof(struct Symbol) + n + 1);
+  if (head is NULL) {
+    Symbol_Pool_Unlock();
+    return throw(OutOfMemoryError, "Cannot intern Symbol, out of memory!");
+  }
+  
+  struct Symbol* s = header_init(head, Symbol, AllocStatic);
+  s->val = (char*)s + sizeof(struct Symbol);
+  s->hash = h;
+  memcpy(s->val, val, n + 1);
+  
+  Symbol_Pool[i] = s;
+  Symbol_Pool_Items++;
+  
+  Symbol_Pool_Unlock();
+  
+  return s;
+}
+
+bool Cello_Interned(void) {
+  Symbol_Pool_Lock();
+  bool interned = Symbol_Pool_Items > 0;
+  Symbol_Pool_Unlock();
+  return interned;
+}
+
+static var Symbol_Pooled(struct Symbol* s) {
+  
+  var found = NULL;
+  
+  Symbol_Pool_Lock();
+  
+  if (Symbol_Pool_Slots isnt 0) {
+    size_t i = s->hash & (Symbol_Pool_Slots - 1);
+    while (Symbol_Pool[i] isnt NULL) {
+      struct Symbol* p = Symbol_Pool[i];
+      if (p->val is s->val) { found = p; break; }
+      i = (i + 1) & (Symbol_Pool_Slots - 1);
+    }
+  }
+  
+  Symbol_Pool_Unlock();
+  
+  return found;
+}
+
+var intern(var self) {
+  
+  /* A Symbol not made by `intern`, such as one on the stack, is not pooled */
+  if (type_of(self) is Symbol) {
+    struct Symbol* s = self;
+    var p = Symbol_Pooled(s);
+    return p isnt NULL ? p : Symbol_Intern(s->val);
+  }
+  
+  return Symbol_Intern(c_str(self));
+}
+
+static void Symbol_Assign(var self, var obj) {
+  struct Symbol* s = self;
+  struct Symbol* o = intern(obj);
+  s->val = o->val;
+  s->hash = o->hash;
+}
+
+static void Symbol_New(var self, var args) {
+  if (len(args) > 0) {
+    Symbol_Assign(self, get(args, $I(0)));
+  } else {
+    Symbol_Assign(self, $S(""));
+  }
+}
+
+/* Equal symbols share their characters so are equal without reading them */
+static int Symbol_Cmp(var self, var obj) {
+  struct Symbol* s = self;
+  char* o = type_of(obj) is Symbol ? ((struct Symbol*)obj)->val : c_str(obj);
+  if (s->val is o) { return 0; }
+  return strcmp(s->val, o);
+}
+
+/* A Symbol made as a literal, such as `$(Symbol, "x", 0)`, has no hash yet */
+static uint64_t Symbol_Hash(var self) {
+  struct Symbol* s = self;
+  if (s->hash is 0) { return hash_data(s->val, strlen(s->val)); }
+  return s->hash;
+}
+
+static size_t Symbol_Len(var self) {
+  struct Symbol* s = self;
+  return strlen(s->val);
+}
+
+static char* Symbol_C_Str(var self) {
+  struct Symbol* s = self;
+  return s->val;
+}
+
+static int Symbol_Show(var self, var output, int pos) {
+  struct Symbol* s = self;
+  return format_to(output, pos, "%s", s->val);
+}
+
+var Symbol = Cello(Symbol,
+  Instance(Doc,
+    Symbol_Name,       Symbol_Brief,    Symbol_Description,
+    Symbol_Definition, Symbol_Examples, Symbol_Methods),
+  Instance(New,     Symbol_New, NULL),
+  Instance(Assign,  Symbol_Assign),
+  Instance(Cmp,     Symbol_Cmp),
+  Instance(Hash,    Symbol_Hash),
+  Instance(Len,     Symbol_Len),
+  Instance(C_Str,   Symbol_C_Str),
+  Instance(Show,    Symbol_Show, NULL));
@@ -16,6 +16,15 @@ static const char* Table_Description(void) {
     "copied into the collection using the `Assign` class and intially have "
     "zero'd memory."
     "\n\n"
+    "Each slot also stores the full hash of its key. Lookups compare these "
+    "hashes before calling `cmp` on the keys, and growing the table never "
+    "needs to hash the keys again."
+    "\n\n"
+    "To build a table from many entries at once use `table_from` with a "
+    "collection of keys and one of values, or `concat` another table onto "
+    "it. These size the table once and insert the entries grouped by slot, "
+    "and when the source is a `Table` its stored hashes are reused."
+    "\n\n"
     "Hash tables provide `O(1)` lookup, insertion and removal can but require "
     "long pauses when the table must be _rehashed_ and all entries processed."
     "\n\n"
@@ -57,6 +66,16 @@ static struct Example* Table_Examples(void) {
       "show($I(len(t))); /* 0 */\n"
       "show($I(mem(t, $S(\"Hello\")))); /* 0 */\n"
       "show($I(mem(t, $S(\"There\")))); /* 0 */\n"
+    }, {
+      "Bulk Construction",
+      "var names = new(Array, String, $S(\"Alice\"), $S(\"Bob\"));\n"
+      "var ages  = new(Array, Int, $I(31), $I(42));\n"
+      "\n"
+      "var t = table_from(names, ages);\n"
+      "show(get(t, $S(\"Bob\"))); /* 42 */\n"
+      "\n"
+      "concat(t, new(Table, String, Int, $S(\"Carol\"), $I(27)));\n"
+      "show($I(len(t))); /* 3 */\n"
     }, {NULL, NULL}
   };
 
@@ -71,35 +90,36 @@ struct Table {
   size_t ksize;
   size_t vsize;
   size_t nslots;
+  size_t nshift;
   size_t nitems;
-  var sspace0;
-  var sspace1;
+  double min_load;
+  double max_load;
 };
 
-enum {
-  TABLE_PRIMES_COUNT = 24
-};
+/*
+**  The table grows once more than `max_load` of its slots are full and
+**  shrinks once fewer than `min_load` are. Both resize to the smallest
+**  power of two which is at most `max_load` full, leaving the load between
+**  half of `max_load` and `max_load`. Keeping `min_load` below half of
+**  `max_load` means a resize never immediately triggers another, so a
+**  table oscillating around a threshold does not rehash on every call. A
+**  `min_load` of zero disables automatic shrinking.
+*/
 
-static const size_t Table_Primes[TABLE_PRIMES_COUNT] = {
-  0,       1,       5,       11,
-  23,      53,      101,     197,
-  389,     683,     1259,    2417,
-  4733,    9371,    18617,   37097,
-  74093,   148073,  296099,  592019,
-  1100009, 2200013, 4400021, 8800019
-};
+static const double Table_Min_Load = 0.2;
+static const double Table_Max_Load = 0.9;
 
-static const double Table_Load_Factor = 0.9;
+static size_t Table_Ideal_Size(struct Table* t, size_t size) {
+  size = (size_t)((double)(size+1) / t->max_load);
+  size_t n = 2;
+  while (n < size) { n = n * 2; }
+  return n;
+}
 
-static size_t Table_Ideal_Size(size_t size) {
-  size = (size_t)((double)(size+1) / Table_Load_Factor);
-  for (size_t i = 0; i < TABLE_PRIMES_COUNT; i++) {
-    if (Table_Primes[i] >= size) { return Table_Primes[i]; }
-  }
-  size_t last = Table_Primes[TABLE_PRIMES_COUNT-1];
-  for (size_t i = 0;; i++) {
-    if (last * i >= size) { return last * i; }
-  }
+static void Table_Set_Slots(struct Table* t, size_t nslots) {
+  t->nslots = nslots;
+  t->nshift = 64;
+  while (nslots > 1) { nslots = nslots / 2; t->nshift--; }
 }
 
 static size_t Table_Step(struct Table* t) {
@@ -127,16 +147,26 @@ static var Table_Val(struct Table* t, uint64_t i) {
     sizeof(struct Header);  
 }
 
+static uint64_t Table_Hash_Of(var key) {
+  uint64_t h = hash(key);
+  return h is 0 ? 1 : h;
+}
+
+/*
+**  Fibonacci hashing takes the top bits of the hash multiplied by 2^64 over
+**  the golden ratio. This spreads sequential or strided hashes, such as
+**  those of `Int`, evenly over the slots and mixes in every bit of the hash.
+*/
+
+static uint64_t Table_Home(struct Table* t, uint64_t h) {
+  return (h * 0x9E3779B97F4A7C15ull) >> t->nshift;
+}
+
 static uint64_t Table_Probe(struct Table* t, uint64_t i, uint64_t h) {
-  int64_t v = i - (h-1);
-  if (v < 0) {
-    v = t->nslots + v;
-  }
-  return v;
+  return (i - Table_Home(t, h)) & (t->nslots-1);
 }
 
 static void Table_Set(var self, var key, var val);
-static void Table_Set_Move(var self, var key, var val, bool move);
 
 static size_t Table_Size_Round(size_t s) {
   return ((s + sizeof(var) - 1) / sizeof(var)) * sizeof(var);
@@ -149,6 +179,8 @@ static void Table_New(var self, var args) {
   t->vtype = cast(get(args, $(Int, 1)), Type);
   t->ksize = Table_Size_Round(size(t->ktype));
   t->vsize = Table_Size_Round(size(t->vtype));
+  t->min_load = Table_Min_Load;
+  t->max_load = Table_Max_Load;
   
   size_t nargs = len(args);
   if (nargs % 2 isnt 0) {
@@ -156,7 +188,7 @@ static void Table_New(var self, var args) {
       "Received non multiple of two argument count to Table constructor.");
   }
   
-  t->nslots = Table_Ideal_Size((nargs-2)/2);
+  Table_Set_Slots(t, Table_Ideal_Size(t, (nargs-2)/2));
   t->nitems = 0;
   
   if (t->nslots is 0) {
@@ -165,11 +197,9 @@ static void Table_New(var self, var args) {
   }
   
   t->data = calloc(t->nslots, Table_Step(t));
-  t->sspace0 = calloc(1, Table_Step(t));
-  t->sspace1 = calloc(1, Table_Step(t));
   
 #if CELLO_MEMORY_CHECK == 1
-  if (t->data is NULL or t->sspace0 is NULL or t->sspace1 is NULL) {
+  if (t->data is NULL) {
     throw(OutOfMemoryError, "Cannot allocate Table, out of memory!");
   }
 #endif
@@ -177,7 +207,7 @@ static void Table_New(var self, var args) {
   for(size_t i = 0; i < (nargs-2)/2; i++) {
     var key = get(args, $(Int, 2+(i*2)+0));
     var val = get(args, $(Int, 2+(i*2)+1));
-    Table_Set_Move(t, key, val, false);
+    Table_Set(t, key, val);
   }
   
 }
@@ -193,8 +223,6 @@ static void Table_Del(var self) {
   }
   
   free(t->data);
-  free(t->sspace0);
-  free(t->sspace1);
   
 }
 
@@ -226,6 +254,8 @@ static void Table_Clear(var self) {
   
 }
 
+static void Table_Concat(var self, var obj);
+
 static void Table_Assign(var self, var obj) {
   struct Table* t = self;  
   Table_Clear(t);
@@ -235,7 +265,15 @@ static void Table_Assign(var self, var obj) {
   t->ksize = Table_Size_Round(size(t->ktype));
   t->vsize = Table_Size_Round(size(t->vtype));
   t->nitems = 0;
-  t->nslots = Table_Ideal_Size(len(obj));
+  
+  if (t->max_load is 0) {
+    struct Table* o = obj;
+    bool table = type_of(obj) is Table;
+    t->min_load = table ? o->min_load : Table_Min_Load;
+    t->max_load = table ? o->max_load : Table_Max_Load;
+  }
+  
+  Table_Set_Slots(t, Table_Ideal_Size(t, len(obj)));
   
   if (t->nslots is 0) {
     t->data = NULL;
@@ -243,21 +281,14 @@ static void Table_Assign(var self, var obj) {
   }
   
   t->data = calloc(t->nslots, Table_Step(t));
-  t->sspace0 = realloc(t->sspace0, Table_Step(t));
-  t->sspace1 = realloc(t->sspace1, Table_Step(t));
   
 #if CELLO_MEMORY_CHECK == 1
-  if (t->data is NULL or t->sspace0 is NULL or t->sspace1 is NULL) {
+  if (t->data is NULL) {
     throw(OutOfMemoryError, "Cannot allocate Table, out of memory!");
   }
 #endif
-
-  memset(t->sspace0, 0, Table_Step(t));
-  memset(t->sspace1, 0, Table_Step(t));
   
-  foreach(key in obj) {
-    Table_Set_Move(t, key, get(obj, key), false);
-  }
+  Table_Concat(t, obj);
   
 }
 
@@ -265,7 +296,7 @@ static var Table_Iter_Init(var self);
 static var Table_Iter_Next(var self, var curr);
 
 static bool Table_Mem(var self, var key);
-static var Table_Get(var self, var key);
+static var Table_Iter_Val(var self, var curr);
 
 static int Table_Cmp(var self, var obj) {
   
@@ -280,7 +311,7 @@ static int Table_Cmp(var self, var obj) {
     c = cmp(item0, item1);
     if (c < 0) { return -1; }
     if (c > 0) { return  1; }
-    c = cmp(Table_Get(self, item0), get(obj, item1));
+    c = cmp(Table_Iter_Val(self, item0), iter_val(obj, item1));
     if (c < 0) { return -1; }
     if (c > 0) { return  1; }
     item0 = Table_Iter_Next(self, item0);
@@ -298,7 +329,7 @@ static uint64_t Table_Hash(var self) {
   var curr = Table_Iter_Init(self);
   while (curr isnt Terminal) {
     var vurr = (char*)curr + t->ksize + sizeof(struct Header);
-    h = h ^ hash(curr) ^ hash(vurr);
+    h += hash_combine(hash(curr), hash(vurr));
     curr = Table_Iter_Next(self, curr);
   }
   
@@ -310,97 +341,153 @@ static size_t Table_Len(var self) {
   return t->nitems;
 }
 
-static uint64_t Table_Swapspace_Hash(struct Table* t, var space) {
-  return *((uint64_t*)space);
+static bool Table_Find(struct Table* t, 
+  var key, uint64_t h, uint64_t* pi, uint64_t* pj) {
+  
+  uint64_t i = Table_Home(t, h);
+  uint64_t j = 0;
+  
+  while (true) {
+    
+    uint64_t s = Table_Key_Hash(t, i);
+    if (s is 0 or j > Table_Probe(t, i, s)) {
+      *pi = i; *pj = j;
+      return false;
+    }
+    
+    if (s is h and eq(Table_Key(t, i), key)) {
+      *pi = i; *pj = j;
+      return true;
+    }
+    
+    i = (i+1) & (t->nslots-1); j++;
+  }
+  
+  return false;
 }
 
-static var Table_Swapspace_Key(struct Table* t, var space) {
-  return (char*)space + sizeof(uint64_t) + sizeof(struct Header);
-}
+/*
+**  In a Robin Hood table the probe lengths along a run of occupied slots
+**  never rise by more than one per slot, so inserting at slot `i` displaces
+**  every entry from `i` up to the next empty slot by exactly one place.
+**  That whole run is moved with at most two `memmove` calls and the new
+**  entry is then written straight into slot `i`. The end of the run is
+**  returned, which is `i` itself if nothing was moved.
+*/
 
-static var Table_Swapspace_Val(struct Table* t, var space) {
-  return (char*)space + sizeof(uint64_t) + sizeof(struct Header) +
-    t->ksize + sizeof(struct Header); 
+static uint64_t Table_Shift(struct Table* t, uint64_t i) {
+  
+  uint64_t e = i;
+  while (Table_Key_Hash(t, e) isnt 0) { e = (e+1) & (t->nslots-1); }
+  if (e is i) { return e; }
+  
+  char* data = t->data;
+  size_t step = Table_Step(t);
+  uint64_t end = e;
+  
+  if (e < i) {
+    memmove(data + step, data, e * step);
+    memcpy(data, data + (t->nslots-1) * step, step);
+    e = t->nslots-1;
+  }
+  
+  memmove(data + (i+1) * step, data + i * step, (e-i) * step);
+  return end;
 }
 
-static void Table_Set_Move(var self, var key, var val, bool move) {
+/*
+**  The key or value being inserted may be an entry of this same table, such
+**  as the result of `get` or a key from iteration. If it was inside the run
+**  moved by `Table_Shift` it is now one slot further along.
+*/
+
+static var Table_Shifted(struct Table* t, var p, uint64_t i, uint64_t e) {
   
-  struct Table* t = self;
-  key = cast(key, t->ktype);
-  val = cast(val, t->vtype);
+  char* data = t->data;
+  size_t step = Table_Step(t);
   
-  uint64_t i = hash(key) % t->nslots;
-  uint64_t j = 0;
+  if ((char*)p < data or (char*)p >= data + t->nslots * step) { return p; }
+  
+  uint64_t s = ((char*)p - data) / step;
+  bool moved = i < e ? (s >= i and s < e) : (s >= i or s < e);
+  
+  if (not moved) { return p; }
+  if (s is t->nslots-1) { return (char*)p - s * step; }
+  return (char*)p + step;
+}
+
+static void Table_Insert(struct Table* t, 
+  var key, var val, bool move, uint64_t h, uint64_t i) {
   
-  memset(t->sspace0, 0, Table_Step(t));
-  memset(t->sspace1, 0, Table_Step(t));
+  char* slot = (char*)t->data + i * Table_Step(t);
+  uint64_t e = Table_Shift(t, i);
   
   if (move) {
-      
-    uint64_t ihash = i+1;
-    memcpy((char*)t->sspace0, &ihash, sizeof(uint64_t));
-    memcpy((char*)t->sspace0 + sizeof(uint64_t),
+    
+    memcpy(slot + sizeof(uint64_t),
       (char*)key - sizeof(struct Header),
       t->ksize + sizeof(struct Header));
-    memcpy((char*)t->sspace0 + sizeof(uint64_t) +
-      sizeof(struct Header) + t->ksize, 
+    memcpy(slot + sizeof(uint64_t) + sizeof(struct Header) + t->ksize,
       (char*)val - sizeof(struct Header),
       t->vsize + sizeof(struct Header));
-  
-  } else {
-        
-    struct Header* khead = (struct Header*)
-      ((char*)t->sspace0 + sizeof(uint64_t));
-    struct Header* vhead = (struct Header*)
-      ((char*)t->sspace0 + sizeof(uint64_t) 
-      + sizeof(struct Header) + t->ksize);
     
-    header_init(khead, t->ktype, AllocData);
-    header_init(vhead, t->vtype, AllocData);
-    
-    uint64_t ihash = i+1;
-    memcpy((char*)t->sspace0, &ihash, sizeof(uint64_t)); 
-    assign((char*)t->sspace0 + sizeof(uint64_t) + sizeof(struct Header), key);
-    assign((char*)t->sspace0 + sizeof(uint64_t) + sizeof(struct Header)
-      + t->ksize + sizeof(struct Header), val);
-  }
-  
-  while (true) {
-    
-    uint64_t h = Table_Key_Hash(t, i);
-    if (h is 0) {
-      memcpy((char*)t->data + i * Table_Step(t), t->sspace0, Table_Step(t));
-      t->nitems++;
-      return;
-    }
+  } else {
     
-    if (eq(Table_Key(t, i), Table_Swapspace_Key(t, t->sspace0))) {
-      destruct(Table_Key(t, i));
-      destruct(Table_Val(t, i));
-      memcpy((char*)t->data + i * Table_Step(t), t->sspace0, Table_Step(t));
-      return;
+    if (e isnt i) {
+      key = Table_Shifted(t, key, i, e);
+      val = Table_Shifted(t, val, i, e);
+      memset(slot, 0, Table_Step(t));
     }
     
-    uint64_t p = Table_Probe(t, i, h);
-    if (j >= p) {
-      memcpy((char*)t->sspace1, (char*)t->data + i * Table_Step(t), Table_Step(t));
-      memcpy((char*)t->data + i * Table_Step(t), (char*)t->sspace0, Table_Step(t));
-      memcpy((char*)t->sspace0, (char*)t->sspace1, Table_Step(t));
-      j = p;
-    }
+    header_init((struct Header*)(slot + sizeof(uint64_t)),
+      t->ktype, AllocData);
+    header_init((struct Header*)(slot + sizeof(uint64_t) +
+      sizeof(struct Header) + t->ksize), t->vtype, AllocData);
     
-    i = (i+1) % t->nslots;
-    j++;
+    assign(Table_Key(t, i), key);
+    assign(Table_Val(t, i), val);
   }
   
+  memcpy(slot, &h, sizeof(uint64_t));
+  t->nitems++;
 }
 
-static void Table_Rehash(struct Table* t, size_t new_size) {
+static var Table_Rehash_Keep(struct Table* t, size_t new_size);
+
+/* Old slots are kept until the insert as key or val may point into them */
+static bool Table_Grow_Keep(struct Table* t, var* old_data) {
+  size_t new_size = Table_Ideal_Size(t, t->nitems+1);
+  if (new_size <= t->nslots) { *old_data = NULL; return false; }
+  *old_data = Table_Rehash_Keep(t, new_size);
+  return true;
+}
+
+static var Table_Upsert(struct Table* t,
+  var key, var val, uint64_t h, bool* found) {
+  
+  uint64_t i, j;
+  
+  if (t->nslots isnt 0 and Table_Find(t, key, h, &i, &j)) {
+    *found = true;
+    return Table_Val(t, i);
+  }
+  
+  var old_data;
+  if (Table_Grow_Keep(t, &old_data)) { Table_Find(t, key, h, &i, &j); }
+  
+  Table_Insert(t, key, val, false, h, i);
+  free(old_data);
+  
+  *found = false;
+  return Table_Val(t, i);
+}
+
+static var Table_Rehash_Keep(struct Table* t, size_t new_size) {
   
   var old_data = t->data;
   size_t old_size = t->nslots;
   
-  t->nslots = new_size;
+  Table_Set_Slots(t, new_size);
   t->nitems = 0;
   t->data = calloc(t->nslots, Table_Step(t));
   
@@ -420,104 +507,238 @@ static void Table_Rehash(struct Table* t, size_t new_size) {
       var val = (char*)old_data + i * Table_Step(t) +
         sizeof(uint64_t) + sizeof(struct Header) + 
         t->ksize + sizeof(struct Header);
-      Table_Set_Move(t, key, val, true);
+      uint64_t j, k = Table_Home(t, h);
+      for (j = 0; Table_Key_Hash(t, k) isnt 0
+      and j <= Table_Probe(t, k, Table_Key_Hash(t, k)); j++) {
+        k = (k+1) & (t->nslots-1);
+      }
+      Table_Insert(t, key, val, true, h, k);
     }
     
   }
   
-  free(old_data);
+  return old_data;
 }
 
-static void Table_Resize_More(struct Table* t) {
-  size_t new_size = Table_Ideal_Size(t->nitems);  
-  size_t old_size = t->nslots;
-  if (new_size > old_size) { Table_Rehash(t, new_size); }
+static void Table_Rehash(struct Table* t, size_t new_size) {
+  free(Table_Rehash_Keep(t, new_size));
 }
 
 static void Table_Resize_Less(struct Table* t) {
-  size_t new_size = Table_Ideal_Size(t->nitems);  
-  size_t old_size = t->nslots;
-  if (new_size < old_size) { Table_Rehash(t, new_size); }
+  if ((double)t->nitems < t->min_load * (double)t->nslots) {
+    size_t new_size = Table_Ideal_Size(t, t->nitems);
+    if (new_size < t->nslots) { Table_Rehash(t, new_size); }
+  }
 }
 
-static bool Table_Mem(var self, var key) {
+static bool Table_Holds_Items(var obj) {
+  var type = type_of(obj);
+  return type is Array or type is Tuple or type is List;
+}
+
+static void Table_Reserve(var self, size_t n) {
   struct Table* t = self;
-  key = cast(key, t->ktype);
+  size_t new_size = Table_Ideal_Size(t, n);
+  if (new_size > t->nslots) { Table_Rehash(t, new_size); }
+}
+
+static void* Table_Batch_Alloc(size_t n, size_t size) {
   
-  if (t->nslots is 0) { return false; }
+  void* data = malloc(n * size);
   
-  uint64_t i = hash(key) % t->nslots;
-  uint64_t j = 0;
+#if CELLO_MEMORY_CHECK == 1
+  if (data is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate Table batch, out of memory!");
+  }
+#endif
   
-  while (true) {
-    
-    uint64_t h = Table_Key_Hash(t, i);
-    if (h is 0 or j > Table_Probe(t, i, h)) {
-      return false;
+  return data;
+}
+
+/*
+**  Bulk insertion sizes the table once and then inserts the entries in
+**  order of their home slot, grouped with a counting sort on the top bits
+**  of the hash. Each entry then lands at or just after the run before it,
+**  so the slots are filled almost sequentially rather than at random. The
+**  sort is stable, so of duplicate keys the last one wins as with `set`.
+*/
+
+enum {
+  TABLE_BUCKET_BITS = 12
+};
+
+static void Table_Build(struct Table* t,
+  size_t n, var* keys, var* vals, uint64_t* hashes) {
+  
+  Table_Reserve(t, t->nitems + n);
+  
+  size_t bits = 64 - t->nshift;
+  if (bits > TABLE_BUCKET_BITS) { bits = TABLE_BUCKET_BITS; }
+  
+  size_t* counts = calloc(((size_t)1 << bits) + 1, sizeof(size_t));
+  size_t* order = Table_Batch_Alloc(n, sizeof(size_t));
+  
+#if CELLO_MEMORY_CHECK == 1
+  if (counts is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate Table batch, out of memory!");
+  }
+#endif
+  
+  for (size_t k = 0; k < n; k++) {
+    counts[((hashes[k] * 0x9E3779B97F4A7C15ull) >> (64 - bits)) + 1]++;
+  }
+  
+  for (size_t b = 0; b < ((size_t)1 << bits); b++) {
+    counts[b+1] += counts[b];
+  }
+  
+  for (size_t k = 0; k < n; k++) {
+    order[counts[(hashes[k] * 0x9E3779B97F4A7C15ull) >> (64 - bits)]++] = k;
+  }
+  
+  for (size_t k = 0; k < n; k++) {
+    size_t o = order[k];
+    bool found;
+    var curr = Table_Upsert(t, keys[o], vals[o], hashes[o], &found);
+    if (found) { assign(curr, vals[o]); }
+  }
+  
+  free(counts);
+  free(order);
+}
+
+static void Table_Concat(var self, var obj) {
+  struct Table* t = self;
+  
+  if (obj is self) { return; }
+  
+  size_t n = len(obj);
+  if (n is 0) { return; }
+  
+  struct Table* o = obj;
+  if (type_of(obj) isnt Table or o->ktype isnt t->ktype) {
+    Table_Reserve(t, t->nitems + n);
+    foreach (key in obj) {
+      Table_Set(t, key, get(obj, key));
     }
-    
-    if (eq(Table_Key(t, i), key)) {
-      return true;
+    return;
+  }
+  
+  var* keys = Table_Batch_Alloc(n, sizeof(var));
+  var* vals = Table_Batch_Alloc(n, sizeof(var));
+  uint64_t* hashes = Table_Batch_Alloc(n, sizeof(uint64_t));
+  
+  size_t k = 0;
+  for (size_t i = 0; i < o->nslots; i++) {
+    uint64_t h = Table_Key_Hash(o, i);
+    if (h is 0) { continue; }
+    keys[k] = Table_Key(o, i);
+    vals[k] = cast(Table_Val(o, i), t->vtype);
+    hashes[k] = h;
+    k++;
+  }
+  
+  Table_Build(t, n, keys, vals, hashes);
+  
+  free(keys);
+  free(vals);
+  free(hashes);
+}
+
+var table_from(var keys, var vals) {
+  
+  var self = new(Table,
+    implements_method(keys, Iter, iter_type) ? iter_type(keys) : Ref,
+    implements_method(vals, Iter, iter_type) ? iter_type(vals) : Ref);
+  
+  struct Table* t = self;
+  
+  size_t n = len(keys);
+  if (len(vals) isnt n) {
+    return throw(FormatError,
+      "Received %i keys but %i values to table_from.", $I(n), $I(len(vals)));
+  }
+  
+  if (not Table_Holds_Items(keys) or not Table_Holds_Items(vals)) {
+    Table_Reserve(t, n);
+    var key = iter_init(keys);
+    var val = iter_init(vals);
+    while (key isnt Terminal and val isnt Terminal) {
+      Table_Set(t, key, val);
+      key = iter_next(keys, key);
+      val = iter_next(vals, val);
     }
-    
-    i = (i+1) % t->nslots; j++;
+    return self;
   }
   
-  return false;
+  var* bkeys = Table_Batch_Alloc(n, sizeof(var));
+  var* bvals = Table_Batch_Alloc(n, sizeof(var));
+  uint64_t* hashes = Table_Batch_Alloc(n, sizeof(uint64_t));
+  
+  var key = iter_init(keys);
+  var val = iter_init(vals);
+  for (size_t k = 0; k < n; k++) {
+    bkeys[k] = cast(key, t->ktype);
+    bvals[k] = cast(val, t->vtype);
+    hashes[k] = Table_Hash_Of(bkeys[k]);
+    key = iter_next(keys, key);
+    val = iter_next(vals, val);
+  }
+  
+  Table_Build(t, n, bkeys, bvals, hashes);
+  
+  free(bkeys);
+  free(bvals);
+  free(hashes);
+  
+  return self;
+}
+
+static bool Table_Mem(var self, var key) {
+  struct Table* t = self;
+  key = cast(key, t->ktype);
+  
+  if (t->nslots is 0) { return false; }
+  
+  uint64_t i, j;
+  return Table_Find(t, key, Table_Hash_Of(key), &i, &j);
 }
 
 static void Table_Rem(var self, var key) {
   struct Table* t = self;
   key = cast(key, t->ktype);
   
-  if (t->nslots is 0) {
+  uint64_t i, j;
+  if (t->nslots is 0 or not Table_Find(t, key, Table_Hash_Of(key), &i, &j)) {
     throw(KeyError, "Key %$ not in Table!", key);
   }
   
-  uint64_t i = hash(key) % t->nslots;
-  uint64_t j = 0;
+  destruct(Table_Key(t, i));
+  destruct(Table_Val(t, i));
+  memset((char*)t->data + i * Table_Step(t), 0, Table_Step(t));
   
   while (true) {
     
-    uint64_t h = Table_Key_Hash(t, i);
-    if (h is 0 or j > Table_Probe(t, i, h)) {
-      throw(KeyError, "Key %$ not in Table!", key);
+    uint64_t ni = (i+1) & (t->nslots-1);
+    uint64_t nh = Table_Key_Hash(t, ni);
+    if (nh isnt 0 and Table_Probe(t, ni, nh) > 0) {
+      memcpy(
+        (char*)t->data + i * Table_Step(t),
+        (char*)t->data + ni * Table_Step(t),
+        Table_Step(t));
+      memset((char*)t->data + ni * Table_Step(t), 0, Table_Step(t));
+      i = ni;
+    } else {
+      break;
     }
     
-    if (eq(Table_Key(t, i), key)) {
-      
-      destruct(Table_Key(t, i));
-      destruct(Table_Val(t, i));
-      memset((char*)t->data + i * Table_Step(t), 0, Table_Step(t));
-      
-      while (true) {
-        
-        uint64_t ni = (i+1) % t->nslots;
-        uint64_t nh = Table_Key_Hash(t, ni);
-        if (nh isnt 0 and Table_Probe(t, ni, nh) > 0) {
-          memcpy(
-            (char*)t->data + i * Table_Step(t),
-            (char*)t->data + ni * Table_Step(t),
-            Table_Step(t));
-          memset((char*)t->data + ni * Table_Step(t), 0, Table_Step(t));
-          i = ni;
-        } else {
-          break;
-        }
-        
-      }
-      
-      t->nitems--;
-      Table_Resize_Less(t);
-      return;
-    }
-    
-    i = (i+1) % t->nslots; j++;
   }
   
+  t->nitems--;
+  Table_Resize_Less(t);
 }
 
-static var Table_Get(var self, var key) {
+static var Table_Try_Get(var self, var key) {
   struct Table* t = self;
   
   if (key >= t->data and ((char*)key) < ((char*)t->data) + t->nslots * Table_Step(self)) {
@@ -526,33 +747,233 @@ static var Table_Get(var self, var key) {
   
   key = cast(key, t->ktype);
   
-  if (t->nslots is 0) {
-    throw(KeyError, "Key %$ not in Table!", key);
+  if (t->nslots is 0) { return NULL; }
+  
+  uint64_t i, j;
+  if (not Table_Find(t, key, Table_Hash_Of(key), &i, &j)) { return NULL; }
+  return Table_Val(t, i);
+}
+
+/*
+**  These look up and set `Int` and `String` keys given as raw C values. They
+**  hash the key as `Int_Hash` and `String_Hash` do and compare it against
+**  the stored key directly, so a probe makes no dynamic calls at all. A raw
+**  string key matches only a stored key of the same length, so a key with a
+**  null character inside it is never found.
+*/
+
+static uint64_t Table_Hash_Int(int64_t key) {
+  uint64_t h = (uint64_t)key;
+  return h is 0 ? 1 : h;
+}
+
+static uint64_t Table_Hash_CStr(const char* key, size_t n) {
+  uint64_t h = hash_data(key, n);
+  return h is 0 ? 1 : h;
+}
+
+static bool Table_Find_Int(struct Table* t,
+  int64_t key, uint64_t h, uint64_t* pi) {
+  
+  uint64_t i = Table_Home(t, h);
+  uint64_t j = 0;
+  
+  while (true) {
+    uint64_t s = Table_Key_Hash(t, i);
+    if (s is 0 or j > Table_Probe(t, i, s)) { *pi = i; return false; }
+    if (s is h and ((struct Int*)Table_Key(t, i))->val is key) {
+      *pi = i; return true;
+    }
+    i = (i+1) & (t->nslots-1); j++;
   }
   
-  uint64_t i = hash(key) % t->nslots;
+  return false;
+}
+
+static bool Table_Find_CStr(struct Table* t,
+  const char* key, size_t n, uint64_t h, uint64_t* pi) {
+  
+  uint64_t i = Table_Home(t, h);
   uint64_t j = 0;
   
   while (true) {
+    uint64_t s = Table_Key_Hash(t, i);
+    if (s is 0 or j > Table_Probe(t, i, s)) { *pi = i; return false; }
+    if (s is h) {
+      char* k = ((struct String*)Table_Key(t, i))->val;
+      if (strlen(k) is n and memcmp(k, key, n) is 0) {
+        *pi = i; return true;
+      }
+    }
+    i = (i+1) & (t->nslots-1); j++;
+  }
+  
+  return false;
+}
+
+static var Table_Try_Get_Int(var self, int64_t key) {
+  struct Table* t = self;
+  uint64_t i;
+  if (t->nslots is 0) { return NULL; }
+  if (not Table_Find_Int(t, key, Table_Hash_Int(key), &i)) { return NULL; }
+  return Table_Val(t, i);
+}
+
+static var Table_Try_Get_CStr(var self, const char* key, size_t n) {
+  struct Table* t = self;
+  uint64_t i;
+  if (t->nslots is 0) { return NULL; }
+  if (not Table_Find_CStr(t, key, n, Table_Hash_CStr(key, n), &i)) {
+    return NULL;
+  }
+  return Table_Val(t, i);
+}
 
-    uint64_t h = Table_Key_Hash(t, i);
-    if (h is 0 or j > Table_Probe(t, i, h)) {
-      throw(KeyError, "Key %$ not in Table!", key);
+static void Table_Set_Int(var self, int64_t key, var val) {
+  struct Table* t = self;
+  val = cast(val, t->vtype);
+  
+  uint64_t i, h = Table_Hash_Int(key);
+  if (t->nslots isnt 0 and Table_Find_Int(t, key, h, &i)) {
+    assign(Table_Val(t, i), val);
+    return;
+  }
+  
+  var old_data;
+  if (Table_Grow_Keep(t, &old_data)) { Table_Find_Int(t, key, h, &i); }
+  
+  Table_Insert(t, $I(key), val, false, h, i);
+  free(old_data);
+}
+
+/*
+**  A new `String` key is inserted empty and then given its characters, so
+**  the raw key is copied once, straight into the table.
+*/
+
+static void Table_Set_CStr(var self, const char* key, size_t n, var val) {
+  struct Table* t = self;
+  val = cast(val, t->vtype);
+  
+  uint64_t i, h = Table_Hash_CStr(key, n);
+  if (t->nslots isnt 0 and Table_Find_CStr(t, key, n, h, &i)) {
+    assign(Table_Val(t, i), val);
+    return;
+  }
+  
+  var old_data;
+  if (Table_Grow_Keep(t, &old_data)) { Table_Find_CStr(t, key, n, h, &i); }
+  
+  Table_Insert(t, $S(""), val, false, h, i);
+  free(old_data);
+  
+  struct String* k = Table_Key(t, i);
+  k->val = realloc(k->val, n+1);
+  
+#if CELLO_MEMORY_CHECK == 1
+  if (k->val is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate String, out of memory!");
+  }
+#endif
+  
+  memcpy(k->val, key, n);
+  k->val[n] = '\0';
+}
+
+/*
+**  Batched lookups hash a block of keys and prefetch each home slot before
+**  probing any of them. On tables larger than the cache this overlaps the
+**  misses of the whole block instead of waiting on each lookup in turn.
+**
+**  Only collections which hold their items can be batched. Iterators such
+**  as `Range` update one object in place, so their keys are looked up one
+**  at a time.
+*/
+
+#if defined(__GNUC__)
+#define TABLE_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define TABLE_PREFETCH(p)
+#endif
+
+enum {
+  TABLE_BATCH = 16
+};
+
+static void Table_Lookup_Many(struct Table* t, var keys, var out, bool vals) {
+  
+  var batch[TABLE_BATCH];
+  uint64_t hashes[TABLE_BATCH];
+  var curr = iter_init(keys);
+  
+  size_t size = Table_Holds_Items(keys) ? TABLE_BATCH : 1;
+  
+  while (curr isnt Terminal) {
+    
+    size_t n = 0;
+    while (true) {
+      batch[n] = cast(curr, t->ktype);
+      hashes[n] = Table_Hash_Of(batch[n]);
+      if (t->nslots isnt 0) {
+        TABLE_PREFETCH((char*)t->data +
+          Table_Home(t, hashes[n]) * Table_Step(t));
+      }
+      n++;
+      if (n is size) { break; }
+      curr = iter_next(keys, curr);
+      if (curr is Terminal) { break; }
     }
     
-    if (eq(Table_Key(t, i), key)) {
-      return Table_Val(t, i);
+    for (size_t k = 0; k < n; k++) {
+      uint64_t i, j;
+      bool found = t->nslots isnt 0
+        and Table_Find(t, batch[k], hashes[k], &i, &j);
+      if (not vals) {
+        push(out, $I(found));
+      } else if (found) {
+        push(out, Table_Val(t, i));
+      } else {
+        throw(KeyError, "Key %$ not in Table!", batch[k]);
+      }
     }
     
-    i = (i+1) % t->nslots; j++;
+    if (curr isnt Terminal) { curr = iter_next(keys, curr); }
   }
   
-  return NULL;
+}
+
+static void Table_Get_Many(var self, var keys, var out) {
+  Table_Lookup_Many(self, keys, out, true);
+}
+
+static void Table_Mem_Many(var self, var keys, var out) {
+  Table_Lookup_Many(self, keys, out, false);
+}
+
+static var Table_Get(var self, var key) {
+  var val = Table_Try_Get(self, key);
+  if (val is NULL) {
+    return throw(KeyError, "Key %$ not in Table!", key);
+  }
+  return val;
 }
 
 static void Table_Set(var self, var key, var val) {
-  Table_Set_Move(self, key, val, false);
-  Table_Resize_More(self);
+  struct Table* t = self;
+  key = cast(key, t->ktype);
+  val = cast(val, t->vtype);
+  
+  bool found;
+  var curr = Table_Upsert(t, key, val, Table_Hash_Of(key), &found);
+  if (found) { assign(curr, val); }
+}
+
+static var Table_Get_Or_Insert(var self, var key, var val) {
+  struct Table* t = self;
+  bool found;
+  key = cast(key, t->ktype);
+  val = cast(val, t->vtype);
+  return Table_Upsert(t, key, val, Table_Hash_Of(key), &found);
 }
 
 static var Table_Iter_Init(var self) {
@@ -625,6 +1046,11 @@ static var Table_Iter_Type(var self) {
   return t->ktype;
 }
 
+static var Table_Iter_Val(var self, var curr) {
+  struct Table* t = self;
+  return (char*)curr + t->ksize + sizeof(struct Header);
+}
+
 static int Table_Show(var self, var output, int pos) {
   struct Table* t = self;
   
@@ -659,7 +1085,39 @@ static void Table_Resize(var self, size_t n) {
   }
 #endif
   
-  Table_Rehash(t, Table_Ideal_Size(n));
+  Table_Rehash(t, Table_Ideal_Size(t, n));
+}
+
+static void Table_Shrink_To_Fit(var self) {
+  struct Table* t = self;
+  
+  if (t->nitems is 0) {
+    Table_Clear(t);
+    return;
+  }
+  
+  size_t new_size = Table_Ideal_Size(t, t->nitems);
+  if (new_size < t->nslots) { Table_Rehash(t, new_size); }
+}
+
+static void Table_Load_Factors(var self, double min_load, double max_load) {
+  struct Table* t = self;
+  
+  if (max_load <= 0 or max_load >= 1 or min_load < 0
+  or  min_load >= max_load / 2) {
+    throw(ValueError,
+      "Invalid Table load factors %f and %f. Expected 0 < max < 1 "
+      "and 0 <= min < max / 2.", $F(min_load), $F(max_load));
+  }
+  
+  t->min_load = min_load;
+  t->max_load = max_load;
+  
+  if (t->nslots isnt 0) {
+    size_t new_size = Table_Ideal_Size(t, t->nitems);
+    if (new_size > t->nslots) { Table_Rehash(t, new_size); }
+    else { Table_Resize_Less(t); }
+  }
 }
 
 static void Table_Mark(var self, var gc, void(*f)(var,void*)) {
@@ -684,10 +1142,16 @@ var Table = Cello(Table,
   Instance(Len,      Table_Len),
   Instance(Get,
     Table_Get, Table_Set, Table_Mem, Table_Rem, 
-    Table_Key_Type, Table_Val_Type),
+    Table_Key_Type, Table_Val_Type, Table_Try_Get, Table_Get_Or_Insert,
+    Table_Try_Get_Int, Table_Try_Get_CStr, Table_Set_Int, Table_Set_CStr,
+    Table_Get_Many, Table_Mem_Many),
   Instance(Iter, 
     Table_Iter_Init, Table_Iter_Next, 
-    Table_Iter_Last, Table_Iter_Prev, Table_Iter_Type),
+    Table_Iter_Last, Table_Iter_Prev, Table_Iter_Type,
+    Table_Iter_Val),
   Instance(Show,     Table_Show, NULL),
-  Instance(Resize,   Table_Resize));
+  Instance(Resize,
+    Table_Resize, Table_Reserve, Table_Shrink_To_Fit,
+    Table_Load_Factors),
+  Instance(Concat,   Table_Concat, NULL));
 
@@ -203,23 +203,14 @@ static uint64_t Thread_Hash(var self) {
   return Thread_C_Int(self);
 }
 
-static bool Thread_TLS_Key_Created = false;
+static CELLO_THREAD_LOCAL var Thread_Local = NULL;
 
 #if defined(CELLO_UNIX)
 
-static pthread_key_t Thread_Key_Wrapper;
-
-static void Thread_TLS_Key_Create(void) {
-  pthread_key_create(&Thread_Key_Wrapper, NULL);
-}
-static void Thread_TLS_Key_Delete(void) {
-  pthread_key_delete(Thread_Key_Wrapper);
-}
-
 static var Thread_Init_Run(var self) {
 
   struct Thread* t = self;  
-  pthread_setspecific(Thread_Key_Wrapper, t);
+  Thread_Local = t;
   t->is_running = true;
   
 #ifndef CELLO_NGC
@@ -244,19 +235,10 @@ static var Thread_Init_Run(var self) {
 
 #elif defined(CELLO_WINDOWS)
 
-static DWORD Thread_Key_Wrapper;
-
-static void Thread_TLS_Key_Create(void) {
-  Thread_Key_Wrapper = TlsAlloc();
-}
-static void Thread_TLS_Key_Delete(void) {
-  TlsFree(Thread_Key_Wrapper);
-}
-
 static DWORD Thread_Init_Run(var self) {
   
   struct Thread* t = self;
-  TlsSetValue(Thread_Key_Wrapper, t);
+  Thread_Local = t;
   t->is_running = true;
   
   var ex = new_raw(Exception);
@@ -291,14 +273,6 @@ static var Thread_Call(var self, var args) {
   
 #if defined(CELLO_UNIX)
   
-  /* Setup Thread Local Storage */
-  
-  if (not Thread_TLS_Key_Created) {
-    Thread_TLS_Key_Create();
-    Thread_TLS_Key_Created = true;
-    atexit(Thread_TLS_Key_Delete);
-  }
-  
   int err = pthread_create(&t->thread, NULL, Thread_Init_Run, t);
   
   if (err is EINVAL) {
@@ -315,14 +289,6 @@ static var Thread_Call(var self, var args) {
   
 #elif defined(CELLO_WINDOWS)
   
-  /* Setup Thread Local Storage */
-  
-  if (not Thread_TLS_Key_Created) {
-    Thread_TLS_Key_Create();
-    Thread_TLS_Key_Created = true;
-    atexit(Thread_TLS_Key_Delete);
-  }
-  
   t->thread = CreateThread(NULL, 0,
     (LPTHREAD_START_ROUTINE)Thread_Init_Run, t, 0, &t->id);
   
@@ -350,55 +316,32 @@ static void Thread_Main_Del(void) {
 
 static var Thread_Current(void) {
   
-  if (not Thread_TLS_Key_Created) {
-    Thread_TLS_Key_Create();
-    Thread_TLS_Key_Created = true;
-    atexit(Thread_TLS_Key_Delete);
-  }
-  
-#if defined(CELLO_UNIX)
-  var wrapper = pthread_getspecific(Thread_Key_Wrapper);
-#elif defined(CELLO_WINDOWS)
-  var wrapper = TlsGetValue(Thread_Key_Wrapper);
-#else
-  var wrapper = NULL;
-#endif
+  if (Thread_Local isnt NULL) { return Thread_Local; }
   
   /*
-  ** Here is a nasty one. On OSX instead of
-  ** returning NULL for an unset key it
-  ** decides to return uninitialized rubbish
-  ** (even though the spec says otherwise).
-  **
-  ** Luckily we can test directly for the main
-  ** thread on OSX using this non-portable method
+  ** Threads not started by Cello, including
+  ** the main thread, all share a single Thread
+  ** object which is created on first use.
   */
-#ifdef CELLO_MAC
-  if (pthread_main_np()) { wrapper = NULL; }
-#endif
   
-  if (wrapper is NULL) {
-  
-    if (Thread_Main is NULL) {
-      Thread_Main = new_raw(Thread);
-      Exception_Main = new_raw(Exception);
-      atexit(Thread_Main_Del);
-    }
-    
-    struct Thread* t = Thread_Main;
-    t->is_main = true;
-    t->is_running = true;
-    
+  if (Thread_Main is NULL) {
+    Thread_Main = new_raw(Thread);
+    Exception_Main = new_raw(Exception);
+    atexit(Thread_Main_Del);
+  }
+  
+  struct Thread* t = Thread_Main;
+  t->is_main = true;
+  t->is_running = true;
+  
 #if defined(CELLO_UNIX)
-    t->thread = pthread_self();
+  t->thread = pthread_self();
 #elif defined(CELLO_WINDOWS)
-    t->thread = GetCurrentThread();
+  t->thread = GetCurrentThread();
 #endif
-
-    return Thread_Main;
-  }
   
-  return wrapper;
+  Thread_Local = Thread_Main;
+  return Thread_Main;
   
 }
 
@@ -426,12 +369,16 @@ static void Thread_Join(var self) {
   
 #if defined(CELLO_UNIX)
   if (not t->thread) { return; }
+  gc_safe_enter();
   int err = pthread_join(t->thread, NULL);
+  gc_safe_leave();
   if (err is EINVAL) { throw(ValueError, "Invalid Argument to Thread Join"); }
   if (err is ESRCH)  { throw(ValueError, "Invalid Thread"); }
 #elif defined(CELLO_WINDOWS)
   if (not t->thread) { return; }
+  gc_safe_enter();
   WaitForSingleObject(t->thread, INFINITE);
+  gc_safe_leave();
 #endif
   
 }
@@ -629,7 +576,9 @@ static void Mutex_Del(var self) {
 static void Mutex_Lock(var self) {
   struct Mutex* m = self;
 #if defined(CELLO_UNIX)
+  gc_safe_enter();
   int err = pthread_mutex_lock(&m->mutex);
+  gc_safe_leave();
   
   if (err is EINVAL)  {
     throw(ValueError, "Invalid Argument to Mutex Lock");
@@ -639,7 +588,9 @@ static void Mutex_Lock(var self) {
     throw(ResourceError, "Attempt to relock already held mutex");
   }
 #elif defined(CELLO_WINDOWS)
+  gc_safe_enter();
   WaitForSingleObject(m->mutex, INFINITE);
+  gc_safe_leave();
 #endif
   
 }
@@ -225,7 +225,7 @@ static var Tree_Iter_Init(var self);
 static var Tree_Iter_Next(var self, var curr);
 
 static bool Tree_Mem(var self, var key);
-static var Tree_Get(var self, var key);
+static var Tree_Iter_Val(var self, var curr);
 
 static int Tree_Cmp(var self, var obj) {
   
@@ -240,7 +240,7 @@ static int Tree_Cmp(var self, var obj) {
     c = cmp(item0, item1);
     if (c < 0) { return -1; }
     if (c > 0) { return  1; }
-    c = cmp(Tree_Get(self, item0), get(obj, item1));
+    c = cmp(Tree_Iter_Val(self, item0), iter_val(obj, item1));
     if (c < 0) { return -1; }
     if (c > 0) { return  1; }
     item0 = Tree_Iter_Next(self, item0);
@@ -258,7 +258,7 @@ static uint64_t Tree_Hash(var self) {
   var curr = Tree_Iter_Init(self);
   while (curr isnt Terminal) {
     var node = (char*)curr - sizeof(struct Header) - 3 * sizeof(var);
-    h = h ^ hash(Tree_Key(m, node)) ^ hash(Tree_Val(m, node));
+    h += hash_combine(hash(Tree_Key(m, node)), hash(Tree_Val(m, node)));
     curr = Tree_Iter_Next(self, curr);
   }
   
@@ -284,7 +284,7 @@ static bool Tree_Mem(var self, var key) {
   return false;
 }
 
-static var Tree_Get(var self, var key) {
+static var Tree_Try_Get(var self, var key) {
   struct Tree* m = self;
   key = cast(key, m->ktype);
   
@@ -295,7 +295,60 @@ static var Tree_Get(var self, var key) {
     node = c < 0 ? *Tree_Left(m, node) : *Tree_Right(m, node);
   }
   
-  return throw(KeyError, "Key %$ not in Tree!", key);
+  return NULL;
+}
+
+/*
+**  These descend using the raw key, ordering it exactly as `Int_Cmp` and
+**  `String_Cmp` would, so no key object is built and no `cmp` is dispatched.
+**  A raw string key is compared over its `n` characters and then by length,
+**  so a key with a null character inside it is never found.
+*/
+
+static int Tree_Cmp_Int(struct Tree* m, var node, int64_t key) {
+  return (int)(((struct Int*)Tree_Key(m, node))->val - key);
+}
+
+static int Tree_Cmp_CStr(struct Tree* m, var node, const char* key, size_t n) {
+  char* k = ((struct String*)Tree_Key(m, node))->val;
+  size_t kn = strlen(k);
+  int c = memcmp(k, key, kn < n ? kn : n);
+  if (c isnt 0) { return c; }
+  return kn < n ? -1 : (kn > n ? 1 : 0);
+}
+
+static var Tree_Try_Get_Int(var self, int64_t key) {
+  struct Tree* m = self;
+  
+  var node = m->root;
+  while (node isnt NULL) {
+    int c = Tree_Cmp_Int(m, node, key);
+    if (c is 0) { return Tree_Val(m, node); }
+    node = c < 0 ? *Tree_Left(m, node) : *Tree_Right(m, node);
+  }
+  
+  return NULL;
+}
+
+static var Tree_Try_Get_CStr(var self, const char* key, size_t n) {
+  struct Tree* m = self;
+  
+  var node = m->root;
+  while (node isnt NULL) {
+    int c = Tree_Cmp_CStr(m, node, key, n);
+    if (c is 0) { return Tree_Val(m, node); }
+    node = c < 0 ? *Tree_Left(m, node) : *Tree_Right(m, node);
+  }
+  
+  return NULL;
+}
+
+static var Tree_Get(var self, var key) {
+  var val = Tree_Try_Get(self, key);
+  if (val is NULL) {
+    return throw(KeyError, "Key %$ not in Tree!", key);
+  }
+  return val;
 }
 
 static var Tree_Key_Type(var self) {
@@ -432,67 +485,121 @@ static void Tree_Set_Fix(struct Tree* m, var node) {
   
 }
 
+static void Tree_Link(struct Tree* m, var* link, var parent, var node) {
+  *link = node;
+  if (parent isnt NULL) { Tree_Set_Parent(m, node, parent); }
+  Tree_Set_Fix(m, node);
+  m->nitems++;
+}
+
+static var Tree_Upsert(struct Tree* m, var key, var val, bool* found) {
+  
+  var* link = &m->root;
+  var parent = NULL;
+  
+  while (*link isnt NULL) {
+    
+    int c = cmp(Tree_Key(m, *link), key);
+    
+    if (c is 0) {
+      *found = true;
+      return *link;
+    }
+    
+    parent = *link;
+    link = c < 0 ? Tree_Left(m, parent) : Tree_Right(m, parent);
+  }
+  
+  var node = Tree_Alloc(m);
+  assign(Tree_Key(m, node), key);
+  assign(Tree_Val(m, node), val);
+  Tree_Link(m, link, parent, node);
+  
+  *found = false;
+  return node;
+}
+
 static void Tree_Set(var self, var key, var val) {
   struct Tree* m = self;
   key = cast(key, m->ktype);
   val = cast(val, m->vtype);
   
-  var node = m->root;
-  
-  if (node is NULL) {
-    var node = Tree_Alloc(m);
+  bool found;
+  var node = Tree_Upsert(m, key, val, &found);
+  if (found) {
     assign(Tree_Key(m, node), key);
     assign(Tree_Val(m, node), val);
-    m->root = node;
-    m->nitems++;
-    Tree_Set_Fix(m, node);
-    return;
   }
+}
+
+static var Tree_Get_Or_Insert(var self, var key, var val) {
+  struct Tree* m = self;
+  bool found;
+  return Tree_Val(m, Tree_Upsert(m, 
+    cast(key, m->ktype), cast(val, m->vtype), &found));
+}
+
+static void Tree_Set_Int(var self, int64_t key, var val) {
+  struct Tree* m = self;
+  val = cast(val, m->vtype);
   
-  while (true) {
-    
-    int c = cmp(Tree_Key(m, node), key);
-    
+  var* link = &m->root;
+  var parent = NULL;
+  
+  while (*link isnt NULL) {
+    int c = Tree_Cmp_Int(m, *link, key);
     if (c is 0) {
-      assign(Tree_Key(m, node), key);
-      assign(Tree_Val(m, node), val);
+      assign(Tree_Val(m, *link), val);
       return;
     }
-    
-    if (c < 0) {
-    
-      if (*Tree_Left(m, node) is NULL) {
-        var newn = Tree_Alloc(m);
-        assign(Tree_Key(m, newn), key);
-        assign(Tree_Val(m, newn), val);
-        *Tree_Left(m, node) = newn;
-        Tree_Set_Parent(m, newn, node);
-        Tree_Set_Fix(m, newn);
-        m->nitems++;
-        return;
-      }
-      
-      node = *Tree_Left(m, node);
-    }
-      
-    if (c > 0) {
-    
-      if (*Tree_Right(m, node) is NULL) {
-        var newn = Tree_Alloc(m);
-        assign(Tree_Key(m, newn), key);
-        assign(Tree_Val(m, newn), val);
-        *Tree_Right(m, node) = newn;
-        Tree_Set_Parent(m, newn, node);
-        Tree_Set_Fix(m, newn);
-        m->nitems++;
-        return;
-      }
-      
-      node = *Tree_Right(m, node);
+    parent = *link;
+    link = c < 0 ? Tree_Left(m, parent) : Tree_Right(m, parent);
+  }
+  
+  var node = Tree_Alloc(m);
+  ((struct Int*)Tree_Key(m, node))->val = key;
+  assign(Tree_Val(m, node), val);
+  Tree_Link(m, link, parent, node);
+}
+
+/*
+**  The characters of a new `String` key are copied straight into the entry
+**  rather than into a temporary `String` first.
+*/
+
+static void Tree_Set_CStr(var self, const char* key, size_t n, var val) {
+  struct Tree* m = self;
+  val = cast(val, m->vtype);
+  
+  var* link = &m->root;
+  var parent = NULL;
+  
+  while (*link isnt NULL) {
+    int c = Tree_Cmp_CStr(m, *link, key, n);
+    if (c is 0) {
+      assign(Tree_Val(m, *link), val);
+      return;
     }
-    
+    parent = *link;
+    link = c < 0 ? Tree_Left(m, parent) : Tree_Right(m, parent);
   }
   
+  var node = Tree_Alloc(m);
+  struct String* k = Tree_Key(m, node);
+  k->val = malloc(n+1);
+  
+#if CELLO_MEMORY_CHECK == 1
+  if (k->val is NULL) {
+    free(node);
+    throw(OutOfMemoryError, "Cannot allocate String, out of memory!");
+    return;
+  }
+#endif
+  
+  memcpy(k->val, key, n);
+  k->val[n] = '\0';
+  assign(Tree_Val(m, node), val);
+  Tree_Link(m, link, parent, node);
 }
 
 static void Tree_Rem_Fix(struct Tree* m, var node) {
@@ -699,6 +806,11 @@ static var Tree_Iter_Type(var self) {
   return m->ktype;
 }
 
+static var Tree_Iter_Val(var self, var curr) {
+  struct Tree* m = self;
+  return (char*)curr + m->ksize + sizeof(struct Header);
+}
+
 static int Tree_Show(var self, var output, int pos) {
   struct Tree* m = self;  
   
@@ -755,11 +867,13 @@ var Tree = Cello(Tree,
   Instance(Len,     Tree_Len),
   Instance(Get, 
     Tree_Get, Tree_Set, Tree_Mem, Tree_Rem, 
-    Tree_Key_Type,  Tree_Val_Type),
+    Tree_Key_Type,  Tree_Val_Type, Tree_Try_Get, Tree_Get_Or_Insert,
+    Tree_Try_Get_Int, Tree_Try_Get_CStr, Tree_Set_Int, Tree_Set_CStr),
   Instance(Resize,  Tree_Resize),
   Instance(Iter, 
     Tree_Iter_Init, Tree_Iter_Next, 
-    Tree_Iter_Last, Tree_Iter_Prev, Tree_Iter_Type),
+    Tree_Iter_Last, Tree_Iter_Prev, Tree_Iter_Type,
+    Tree_Iter_Val),
   Instance(Show,    Tree_Show, NULL));
 
 
@@ -27,13 +27,19 @@ static const char* Tuple_Description(void) {
     "\n\n"
     "Because Tuples are terminated with the Cello `Terminal` object this can't "
     "naturally be included within them. This object should therefore only be "
-    "returned from iteration functions.";
+    "returned from iteration functions."
+    "\n\n"
+    "A Tuple used as a key whose items will not change can have its hash "
+    "stored with `hash_cache`, so repeated lookups do not hash every item "
+    "again. Changing the Tuple itself clears the stored hash, but changing an "
+    "item it points to does not.";
 }
 
 static const char* Tuple_Definition(void) {
   return
     "struct Tuple {\n"
     "  var* items;\n"
+    "  uint64_t hash;\n"
     "};\n";
 }
 
@@ -65,6 +71,11 @@ static struct Method* Tuple_Methods(void) {
       "tuple", 
       "#define tuple(...)",
       "Construct a `Tuple` object on the stack."
+    }, {
+      "hash_cache",
+      "void hash_cache(var self);",
+      "Compute and store the hash of the Tuple `self` so that `hash` returns "
+      "it without looking at the items."
     }, {NULL, NULL, NULL}
   };
   
@@ -88,6 +99,7 @@ static void Tuple_New(var self, var args) {
   }
   
   t->items[nargs] = Terminal;
+  t->hash = 0;
 }
 
 static void Tuple_Del(var self) {
@@ -107,6 +119,7 @@ static void Tuple_Push(var self, var obj);
 
 static void Tuple_Assign(var self, var obj) {
   struct Tuple* t = self;
+  t->hash = 0;
   
   if (implements_method(obj, Len, len)
   and implements_method(obj, Get, get)) {
@@ -133,6 +146,10 @@ static void Tuple_Assign(var self, var obj) {
     }
     
     t->items[nargs] = Terminal;
+    
+    if (type_of(obj) is Tuple) {
+      t->hash = ((struct Tuple*)obj)->hash;
+    }
   
   } else {
     
@@ -199,6 +216,15 @@ static var Tuple_Get(var self, var key) {
   return t->items[i];
 }
 
+static var Tuple_Try_Get(var self, var key) {
+  struct Tuple* t = self;
+  size_t nitems = Tuple_Len(t);
+  int64_t i = c_int(key);
+  i = i < 0 ? nitems+i : i;
+  if (i < 0 or i >= (int64_t)nitems) { return NULL; }
+  return t->items[i];
+}
+
 static void Tuple_Set(var self, var key, var val) {
   struct Tuple* t = self;
   size_t nitems = Tuple_Len(t);
@@ -216,6 +242,7 @@ static void Tuple_Set(var self, var key, var val) {
 #endif
 
   t->items[i] = val;
+  t->hash = 0;
 }
 
 static bool Tuple_Mem(var self, var item) {
@@ -273,6 +300,7 @@ static void Tuple_Push(var self, var obj) {
   
   t->items[nitems+0] = obj;
   t->items[nitems+1] = Terminal;
+  t->hash = 0;
   
 }
 
@@ -297,6 +325,7 @@ static void Tuple_Pop(var self) {
   
   t->items = realloc(t->items, sizeof(var) * nitems);
   t->items[nitems-1] = Terminal;
+  t->hash = 0;
   
 }
 
@@ -334,6 +363,7 @@ static void Tuple_Push_At(var self, var obj, var key) {
     sizeof(var) * (nitems - (size_t)i + 1));
     
   t->items[i] = obj;
+  t->hash = 0;
   
 }
 
@@ -362,6 +392,7 @@ static void Tuple_Pop_At(var self, var key) {
 #endif
   
   t->items = realloc(t->items, sizeof(var) * nitems);
+  t->hash = 0;
   
 }
 
@@ -393,6 +424,7 @@ static void Tuple_Concat(var self, var obj) {
   }
   
   t->items[nitems+objlen] = Terminal;
+  t->hash = 0;
   
 }
 
@@ -411,6 +443,7 @@ static void Tuple_Resize(var self, size_t n) {
   if (n < m) {
     t->items = realloc(t->items, sizeof(var) * (n+1));
     t->items[n] = Terminal;
+    t->hash = 0;
   } else {
     throw(FormatError, 
       "Cannot resize Tuple to %li as it only contains %li items", 
@@ -462,7 +495,9 @@ static void Tuple_Sort_Part(
 }
 
 static void Tuple_Sort_By(var self, bool(*f)(var,var)) {
-  Tuple_Sort_Part(self, 0, Tuple_Len(self)-1, f);
+  struct Tuple* t = self;
+  Tuple_Sort_Part(t, 0, Tuple_Len(t)-1, f);
+  t->hash = 0;
 }
 
 static int Tuple_Cmp(var self, var obj) {
@@ -487,18 +522,26 @@ static int Tuple_Cmp(var self, var obj) {
   return 0;
 }
 
-static uint64_t Tuple_Hash(var self) {
-  struct Tuple* t = self;
+static uint64_t Tuple_Hash_Items(struct Tuple* t) {
   uint64_t h = 0;
-  
-  size_t n = Tuple_Len(self);
-  for (size_t i = 0; i < n; i++) {
-    h ^= hash(t->items[i]);
+  if (t->items is NULL) { return h; }
+  for (size_t i = 0; t->items[i] isnt Terminal; i++) {
+    h = hash_combine(h, hash(t->items[i]));
   }
-  
   return h;
 }
 
+static uint64_t Tuple_Hash(var self) {
+  struct Tuple* t = self;
+  if (t->hash isnt 0) { return t->hash; }
+  return Tuple_Hash_Items(t);
+}
+
+void hash_cache(var self) {
+  struct Tuple* t = cast(self, Tuple);
+  t->hash = Tuple_Hash_Items(t);
+}
+
 var Tuple = Cello(Tuple,
   Instance(Doc,
     Tuple_Name,       Tuple_Brief,    Tuple_Description, 
@@ -508,7 +551,9 @@ var Tuple = Cello(Tuple,
   Instance(Cmp,      Tuple_Cmp),
   Instance(Hash,     Tuple_Hash),
   Instance(Len,      Tuple_Len),
-  Instance(Get,      Tuple_Get, Tuple_Set, Tuple_Mem, Tuple_Rem),
+  Instance(Get,      
+    Tuple_Get, Tuple_Set, Tuple_Mem, Tuple_Rem, 
+    NULL, NULL, Tuple_Try_Get),
   Instance(Push,     Tuple_Push, Tuple_Pop, Tuple_Push_At, Tuple_Pop_At),
   Instance(Concat,   Tuple_Concat, Tuple_Push),
   Instance(Resize,   Tuple_Resize),
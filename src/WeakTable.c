@@ -0,0 +1,233 @@
+#include "Cello.h"
+
+static const char* WeakTable_Name(void) {
+  return "WeakTable";
+}
+
+static const char* WeakTable_Brief(void) {
+  return "Hash table with weak values";
+}
+
+static const char* WeakTable_Description(void) {
+  return
+    "The `WeakTable` type is a hash table which maps keys to objects without "
+    "keeping those objects alive. Keys are copied into the collection as in a "
+    "`Table` but values are stored as `WeakRef` objects, so once a value is "
+    "collected by the Garbage Collector its entry disappears from the table."
+    "\n\n"
+    "Dead entries are removed lazily. Looking up a key whose value has died "
+    "acts as if the key were missing, and iteration and `show` skip such "
+    "keys, but none of these change the table, so they are all safe during "
+    "iteration. `len` counts the live entries, which makes it an `O(n)` "
+    "operation. Dead entries are removed by `set` each time the table has "
+    "doubled in size since the last time, or at once by `shrink_to_fit`."
+    "\n\n"
+    "This is useful for caches which should not pin the objects they hold.";
+}
+
+static struct Example* WeakTable_Examples(void) {
+  
+  static struct Example examples[] = {
+    {
+      "Usage",
+      "var cache = new(WeakTable, String);\n"
+      "set(cache, $S(\"Hello\"), new(String, $S(\"World\")));\n"
+      "\n"
+      "if (mem(cache, $S(\"Hello\"))) {\n"
+      "  show(get(cache, $S(\"Hello\"))); /* World */\n"
+      "}\n"
+    }, {NULL, NULL}
+  };
+  
+  return examples;
+  
+}
+
+struct WeakTable {
+  var table;
+  size_t limit;
+};
+
+enum {
+  WEAKTABLE_MIN_LIMIT = 16
+};
+
+static void WeakTable_Purge(struct WeakTable* w) {
+  
+  var dead = new_raw(Array, key_type(w->table));
+  
+  foreach (key in w->table) {
+    if (deref(iter_val(w->table, key)) is NULL) {
+      push(dead, key);
+    }
+  }
+  
+  foreach (key in dead) {
+    rem(w->table, key);
+  }
+  
+  del_raw(dead);
+  
+  w->limit = len(w->table) * 2;
+  if (w->limit < WEAKTABLE_MIN_LIMIT) { w->limit = WEAKTABLE_MIN_LIMIT; }
+}
+
+static void WeakTable_Set(var self, var key, var val);
+
+static void WeakTable_New(var self, var args) {
+  struct WeakTable* w = self;
+  w->table = new_raw(Table, cast(get(args, $I(0)), Type), WeakRef);
+  w->limit = WEAKTABLE_MIN_LIMIT;
+  
+  size_t nargs = len(args);
+  if (nargs % 2 isnt 1) {
+    throw(FormatError,
+      "Received non multiple of two argument count to WeakTable constructor.");
+  }
+  
+  for (size_t i = 0; i < (nargs-1)/2; i++) {
+    var key = get(args, $I(1+(i*2)+0));
+    var val = get(args, $I(1+(i*2)+1));
+    WeakTable_Set(self, key, val);
+  }
+  
+}
+
+static void WeakTable_Del(var self) {
+  struct WeakTable* w = self;
+  del_raw(w->table);
+}
+
+static void WeakTable_Assign(var self, var obj) {
+  struct WeakTable* w = self;
+  
+  if (w->table isnt NULL) { del_raw(w->table); }
+  w->table = new_raw(Table, 
+    implements_method(obj, Get, key_type) ? key_type(obj) : Ref, WeakRef);
+  w->limit = WEAKTABLE_MIN_LIMIT;
+  
+  foreach (key in obj) {
+    WeakTable_Set(self, key, get(obj, key));
+  }
+  
+}
+
+static var WeakTable_Iter_Live(struct WeakTable* w, var curr) {
+  while (curr isnt Terminal and deref(iter_val(w->table, curr)) is NULL) {
+    curr = iter_next(w->table, curr);
+  }
+  return curr;
+}
+
+static size_t WeakTable_Len(var self) {
+  struct WeakTable* w = self;
+  size_t n = 0;
+  var curr = WeakTable_Iter_Live(w, iter_init(w->table));
+  while (curr isnt Terminal) {
+    n++;
+    curr = WeakTable_Iter_Live(w, iter_next(w->table, curr));
+  }
+  return n;
+}
+
+static var WeakTable_Get(var self, var key) {
+  struct WeakTable* w = self;
+  
+  var ref = try_get(w->table, key);
+  var val = ref is NULL ? NULL : deref(ref);
+  if (val is NULL) {
+    return throw(KeyError, "Key %$ not in WeakTable!", key);
+  }
+  
+  return val;
+}
+
+static var WeakTable_Try_Get(var self, var key) {
+  struct WeakTable* w = self;
+  
+  var ref = try_get(w->table, key);
+  return ref is NULL ? NULL : deref(ref);
+}
+
+static void WeakTable_Set(var self, var key, var val) {
+  struct WeakTable* w = self;
+  set(w->table, key, $(WeakRef, val));
+  if (len(w->table) > w->limit) { WeakTable_Purge(w); }
+}
+
+static bool WeakTable_Mem(var self, var key) {
+  return WeakTable_Try_Get(self, key) isnt NULL;
+}
+
+static void WeakTable_Rem(var self, var key) {
+  struct WeakTable* w = self;
+  rem(w->table, key);
+}
+
+static var WeakTable_Key_Type(var self) {
+  struct WeakTable* w = self;
+  return key_type(w->table);
+}
+
+static var WeakTable_Val_Type(var self) {
+  return Ref;
+}
+
+static var WeakTable_Iter_Init(var self) {
+  struct WeakTable* w = self;
+  return WeakTable_Iter_Live(w, iter_init(w->table));
+}
+
+static var WeakTable_Iter_Next(var self, var curr) {
+  struct WeakTable* w = self;
+  return WeakTable_Iter_Live(w, iter_next(w->table, curr));
+}
+
+static var WeakTable_Iter_Type(var self) {
+  struct WeakTable* w = self;
+  return iter_type(w->table);
+}
+
+static int WeakTable_Show(var self, var output, int pos) {
+  struct WeakTable* w = self;
+  
+  pos = print_to(output, pos, "<'WeakTable' At 0x%p {", self);
+  
+  var curr = WeakTable_Iter_Init(self);
+  while (curr isnt Terminal) {
+    pos = print_to(output, pos, "%$:%$",
+      curr, deref(iter_val(w->table, curr)));
+    curr = WeakTable_Iter_Next(self, curr);
+    if (curr isnt Terminal) { pos = print_to(output, pos, ", "); }
+  }
+  
+  return print_to(output, pos, "}>");
+}
+
+static void WeakTable_Shrink_To_Fit(var self) {
+  struct WeakTable* w = self;
+  WeakTable_Purge(w);
+  shrink_to_fit(w->table);
+}
+
+static void WeakTable_Mark(var self, var gc, void(*f)(var,void*)) {
+  struct WeakTable* w = self;
+  mark(w->table, gc, f);
+}
+
+var WeakTable = Cello(WeakTable,
+  Instance(Doc,
+    WeakTable_Name, WeakTable_Brief,    WeakTable_Description,
+    NULL,           WeakTable_Examples, NULL),
+  Instance(New,      WeakTable_New, WeakTable_Del),
+  Instance(Assign,   WeakTable_Assign),
+  Instance(Mark,     WeakTable_Mark),
+  Instance(Len,      WeakTable_Len),
+  Instance(Get,
+    WeakTable_Get, WeakTable_Set, WeakTable_Mem, WeakTable_Rem,
+    WeakTable_Key_Type, WeakTable_Val_Type, WeakTable_Try_Get),
+  Instance(Iter,
+    WeakTable_Iter_Init, WeakTable_Iter_Next,
+    NULL, NULL, WeakTable_Iter_Type),
+  Instance(Show,     WeakTable_Show, NULL),
+  Instance(Resize,   NULL, NULL, WeakTable_Shrink_To_Fit, NULL));
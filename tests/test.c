@@ -145,10 +145,17 @@ PT_FUNC(test_array_get) {
 PT_FUNC(test_array_hash) {
   
   var a0 = new(Array, String, $S("Hello"), $S("World"));
+  var a1 = new(Array, String, $S("World"), $S("Hello"));
+  var a2 = new(Array, Int, $I(1), $I(1));
   
-  PT_ASSERT(hash(a0) is (hash($S("Hello")) ^ hash($S("World"))));
+  PT_ASSERT(hash(a0) is hash_combine(
+    hash_combine(0, hash($S("Hello"))), hash($S("World"))));
+  PT_ASSERT(hash(a0) isnt hash(a1));
+  PT_ASSERT(hash(a2) isnt 0);
   
   del(a0);
+  del(a1);
+  del(a2);
   
 }
 
@@ -288,6 +295,41 @@ PT_FUNC(test_array_resize) {
   
 }
 
+PT_FUNC(test_array_reserve) {
+  
+  var a0 = new(Array, Int, $I(0));
+  reserve(a0, 1000);
+  
+  var first = get(a0, $I(0));
+  for (size_t i = 1; i < 1000; i++) { push(a0, $I(i)); }
+  PT_ASSERT(get(a0, $I(0)) is first);
+  
+  reserve(a0, 10);
+  PT_ASSERT(len(a0) is 1000);
+  PT_ASSERT(get(a0, $I(0)) is first);
+  
+  load_factors(a0, 0.0, 0.5);
+  for (size_t i = 1; i < 1000; i++) { pop(a0); }
+  PT_ASSERT(len(a0) is 1);
+  PT_ASSERT(get(a0, $I(0)) is first);
+  
+  shrink_to_fit(a0);
+  PT_ASSERT(eq(get(a0, $I(0)), $I(0)));
+  for (size_t i = 1; i < 100; i++) { push(a0, $I(i)); }
+  PT_ASSERT(eq(get(a0, $I(99)), $I(99)));
+  
+  var a1 = copy(a0);
+  PT_ASSERT(eq(a0, a1));
+  
+  var e = NULL;
+  try { load_factors(a0, 0.5, 0.5); } catch (err in ValueError) { e = err; }
+  PT_ASSERT(e is ValueError);
+  
+  del(a0);
+  del(a1);
+  
+}
+
 PT_FUNC(test_array_show) {
   
   var a0 = new(Array, Int, $I(1), $I(5), $I(9));
@@ -336,6 +378,7 @@ PT_SUITE(suite_array) {
   PT_REG(test_array_len);
   PT_REG(test_array_push);
   PT_REG(test_array_resize);
+  PT_REG(test_array_reserve);
   PT_REG(test_array_show);
   PT_REG(test_array_sort);
 }
@@ -393,11 +436,61 @@ PT_FUNC(test_box_show) {
   
 }
 
+static size_t BoxTestDestructed = 0;
+
+struct BoxTest {
+  int64_t data;
+};
+
+static void BoxTest_Del(var self) {
+  BoxTestDestructed++;
+}
+
+static var BoxTest = Cello(BoxTest,
+  Instance(New, NULL, BoxTest_Del));
+
+PT_FUNC(test_box_release) {
+  
+  var b0 = new(Box, new(BoxTest));
+  var a0 = new(Array, Box, b0, b0);
+  
+  del(b0);
+#ifdef CELLO_RC
+  PT_ASSERT(BoxTestDestructed is 0);
+#endif
+  
+  pop(a0);
+#ifdef CELLO_RC
+  PT_ASSERT(BoxTestDestructed is 0);
+#endif
+  
+  del(a0);
+#ifdef CELLO_RC
+  PT_ASSERT(BoxTestDestructed is 1);
+  
+  var b1 = new(Box, new(BoxTest));
+  var b2 = new(Box, new(BoxTest));
+  var b3 = new(Box, b2);
+  
+  assign(b1, b2);
+  PT_ASSERT(BoxTestDestructed is 2);
+  
+  del(b1);
+  del(b2);
+  PT_ASSERT(BoxTestDestructed is 2);
+  
+  del(b3);
+  PT_ASSERT(BoxTestDestructed is 3);
+#endif
+  
+}
+
 PT_SUITE(suite_box) {
   PT_REG(test_box_new);
   PT_REG(test_box_assign);
   PT_REG(test_box_pointer);
   PT_REG(test_box_show);
+  PT_REG(test_box_release);
 }
 
 /* File */
@@ -646,6 +739,286 @@ PT_SUITE(suite_function) {
   PT_REG(test_function_call);
 }
 
+/* GC */
+
+static var GCTestMain = NULL;
+static size_t GCTestAsyncOnMain = 0;
+static size_t GCTestAsyncOffMain = 0;
+static size_t GCTestLocalOnMain = 0;
+static size_t GCTestLocalOffMain = 0;
+
+struct GCTest {
+  int64_t data;
+};
+
+struct GCTestLocal {
+  int64_t data;
+};
+
+static void GCTest_Del(var self) {
+  if (current(Thread) is GCTestMain) {
+    GCTestAsyncOnMain++;
+  } else {
+    GCTestAsyncOffMain++;
+  }
+}
+
+static void GCTestLocal_Del(var self) {
+  if (current(Thread) is GCTestMain) {
+    GCTestLocalOnMain++;
+  } else {
+    GCTestLocalOffMain++;
+  }
+}
+
+static bool GCTestLocal_Local(var self) {
+  return true;
+}
+
+static var GCTest = Cello(GCTest,
+  Instance(New, NULL, GCTest_Del));
+
+static var GCTestLocal = Cello(GCTestLocal,
+  Instance(New, NULL, GCTestLocal_Del),
+  Instance(Finalize, GCTestLocal_Local));
+
+static void test_gc_finalize_async_alloc(void) {
+  for (size_t i = 0; i < 100; i++) {
+    new(GCTest);
+    new(GCTestLocal);
+  }
+}
+
+PT_FUNC(test_gc_finalize_async) {
+  
+  GCTestMain = current(Thread);
+  
+  var gc = current(GC);
+  gc_finalize_async(gc, true);
+  
+  test_gc_finalize_async_alloc();
+  for (size_t i = 0; i < 10000; i++) { new(Int, $I(i)); }
+  
+  gc_finalize_async(gc, false);
+  
+  PT_ASSERT(GCTestAsyncOffMain > 0);
+  PT_ASSERT(GCTestAsyncOnMain is 0);
+  PT_ASSERT(GCTestLocalOnMain > 0);
+  PT_ASSERT(GCTestLocalOffMain is 0);
+  
+}
+
+static void test_gc_weak_alloc(var weaks, var cache) {
+  for (size_t i = 0; i < 100; i++) {
+    var x = new(Int, $I(i));
+    push(weaks, $(WeakRef, x));
+    set(cache, $I(i), x);
+  }
+}
+
+PT_FUNC(test_gc_weak) {
+  
+  var live = new(Int, $I(-1));
+  var weaks = new(Array, WeakRef, $(WeakRef, live));
+  var cache = new(WeakTable, Int, $I(-1), live);
+  
+  test_gc_weak_alloc(weaks, cache);
+  for (size_t i = 0; i < 10000; i++) { new(Int, $I(i)); }
+  
+  size_t cleared = 0;
+  foreach (w in weaks) {
+    if (deref(w) is NULL) { cleared++; }
+  }
+  
+  PT_ASSERT(cleared > 0);
+  PT_ASSERT(deref(get(weaks, $I(0))) is live);
+  
+  PT_ASSERT(len(cache) < 101);
+  PT_ASSERT(mem(cache, $I(-1)));
+  PT_ASSERT(get(cache, $I(-1)) is live);
+  
+  foreach (key in cache) {
+    PT_ASSERT(type_of(get(cache, key)) is Int);
+  }
+  
+  /* A NULL value stands in for one the collector has cleared */
+  var weak = new(WeakTable, Int, $I(1), live, $I(2), NULL, $I(3), live);
+  
+  bool reached = false;
+  try {
+    get(weak, $I(2));
+  } catch (e in KeyError) {
+    reached = true;
+  }
+  
+  PT_ASSERT(reached);
+  PT_ASSERT(not mem(weak, $I(2)));
+  PT_ASSERT(try_get(weak, $I(2)) is NULL);
+  PT_ASSERT(len(weak) is 2);
+  
+  size_t n = 0;
+  foreach (key in weak) {
+    if (n is 0) {
+      set(weak, $I(1), NULL);
+      set(weak, $I(3), NULL);
+    }
+    PT_ASSERT(not mem(weak, key));
+    PT_ASSERT(try_get(weak, key) is NULL);
+    n++;
+  }
+  
+  PT_ASSERT(n is 1);
+  PT_ASSERT(len(weak) is 0);
+  shrink_to_fit(weak);
+  PT_ASSERT(len(weak) is 0);
+  PT_ASSERT(iter_init(weak) is Terminal);
+  
+  PT_ASSERT(c_int(live) is -1);
+  
+}
+
+static var GCTestShared = NULL;
+static var GCTestSharedMutex = NULL;
+static int64_t GCTestSharedBase = 0;
+static bool GCTestSharedIntact = false;
+static var GCTestSharedHand = NULL;
+static bool GCTestSharedDone = false;
+static bool GCTestSharedFound = false;
+
+static var test_gc_shared_worker(var args) {
+  
+  lock(GCTestSharedMutex);
+  int64_t base = GCTestSharedBase;
+  GCTestSharedBase += 100000;
+  unlock(GCTestSharedMutex);
+  
+  for (int64_t i = 0; i < 5000; i++) {
+    var x = new(Int, $I(base + i));
+    if (i % 100 is 0) {
+      lock(GCTestSharedMutex);
+      push(GCTestShared, x);
+      unlock(GCTestSharedMutex);
+    }
+  }
+  return NULL;
+}
+
+static var test_gc_shared_holder(var args) {
+  
+  var x = new(Int, $I(7));
+  
+  lock(GCTestSharedMutex);
+  GCTestSharedHand = x;
+  unlock(GCTestSharedMutex);
+  
+  bool done = false;
+  while (not done) {
+    lock(GCTestSharedMutex);
+    done = GCTestSharedDone;
+    unlock(GCTestSharedMutex);
+  }
+  
+  return NULL;
+}
+
+static var test_gc_shared_owner(var args) {
+  
+  var gc = current(GC);
+  gc_shared(gc, true);
+  
+  GCTestShared = new_root(Tuple);
+  GCTestSharedMutex = new_root(Mutex);
+  
+  var func = $(Function, test_gc_shared_worker);
+  var workers[4];
+  for (size_t i = 0; i < 4; i++) {
+    workers[i] = new(Thread, func);
+    call(workers[i]);
+  }
+  
+  for (size_t i = 0; i < 10000; i++) { new(Int, $I(i)); }
+  
+  for (size_t i = 0; i < 4; i++) { join(workers[i]); }
+  
+  /* Still only in the holding thread's allocation buffer */
+  var holder = new(Thread, $(Function, test_gc_shared_holder));
+  call(holder);
+  
+  var hand = NULL;
+  while (hand is NULL) {
+    lock(GCTestSharedMutex);
+    hand = GCTestSharedHand;
+    unlock(GCTestSharedMutex);
+  }
+  
+  GCTestSharedFound = mem(gc, hand);
+  del(hand);
+  
+  lock(GCTestSharedMutex);
+  GCTestSharedDone = true;
+  unlock(GCTestSharedMutex);
+  join(holder);
+  
+  gc_shared(gc, false);
+  
+  for (size_t i = 0; i < 10000; i++) { new(Int, $I(i)); }
+  
+  GCTestSharedIntact = len(GCTestShared) is 200;
+  foreach (x in GCTestShared) {
+    int64_t v = c_int(x);
+    if (v % 100 isnt 0 or v < 0 or v >= 400000) {
+      GCTestSharedIntact = false;
+    }
+  }
+  
+  del_root(GCTestShared);
+  del_root(GCTestSharedMutex);
+  
+  return NULL;
+}
+
+PT_FUNC(test_gc_shared) {
+  var t = new(Thread, $(Function, test_gc_shared_owner));
+  call(t);
+  join(t);
+  PT_ASSERT(GCTestSharedIntact);
+  PT_ASSERT(GCTestSharedFound);
+}
+
+PT_FUNC(test_gc_root) {
+  
+  var gc = current(GC);
+  var x = NULL, w = NULL;
+  
+  with (r0 in $(Root, &x))
+  with (r1 in $(Root, &w)) {
+    
+    gc_stack_scan(gc, false);
+    
+    x = new(String, $S("Hello"));
+    w = new(WeakRef);
+    ref(w, new(Int, $I(1)));
+    for (size_t i = 0; i < 10000; i++) { new(Int, $I(i)); }
+    
+    gc_stack_scan(gc, true);
+    
+    PT_ASSERT(eq(x, $S("Hello")));
+    PT_ASSERT(deref(w) is NULL);
+  }
+  
+  bool thrown = false;
+  try { gc_root_pop(gc); } catch (e in IndexOutOfBoundsError) { thrown = true; }
+  PT_ASSERT(thrown);
+  
+}
+
+PT_SUITE(suite_gc) {
+  PT_REG(test_gc_finalize_async);
+  PT_REG(test_gc_weak);
+  PT_REG(test_gc_shared);
+  PT_REG(test_gc_root);
+}
+
 /* Int */
 
 PT_FUNC(test_int_assign) {
@@ -877,7 +1250,8 @@ PT_FUNC(test_list_hash) {
   
   var l0 = new(List, String, $S("Hello"), $S("World"));
   
-  PT_ASSERT(hash(l0) is (hash($S("Hello")) ^ hash($S("World"))));
+  PT_ASSERT(hash(l0) is hash_combine(
+    hash_combine(0, hash($S("Hello"))), hash($S("World"))));
   
   del(l0);
   
@@ -1616,13 +1990,32 @@ PT_FUNC(test_string_get) {
 
 PT_FUNC(test_string_hash) {
   
-  uint64_t v0 = 4771441285123272284ULL;
-  uint64_t v1 = 17415363727859751682ULL;
-  uint64_t v2 = 11867268813077774525ULL;
+  uint64_t v0 = 17512215253140907672ULL;
+  uint64_t v1 = 4367638403561714810ULL;
+  uint64_t v3 = 13147027442107112133ULL;
+  uint64_t v2 = 14063058129171862482ULL;
   
   PT_ASSERT(hash($S("Hello")) is v0);
   PT_ASSERT(hash($S("There")) is v1);
   PT_ASSERT(hash($S("People")) is v2);
+  PT_ASSERT(hash($S("Hello World!")) is v3);
+  
+  char long0[200], long1[200];
+  memset(long0, 'x', sizeof(long0));
+  memset(long1, 'x', sizeof(long1));
+  long1[150] = 'y';
+  
+  for (size_t i = 0; i < sizeof(long0); i++) {
+    PT_ASSERT(hash_data(long0, i) is hash_data(long1, i) or i > 150);
+    PT_ASSERT(hash_data(long0, i) isnt hash_data(long0, i+1));
+  }
+  PT_ASSERT(hash_data(long0, 200) isnt hash_data(long1, 200));
+  
+  hash_seed(1);
+  uint64_t s0 = hash_data("Hello", 5);
+  hash_seed(0xCe110);
+  PT_ASSERT(s0 isnt v0);
+  PT_ASSERT(hash_data("Hello", 5) is v0);
   
 }
 
@@ -1700,6 +2093,66 @@ PT_FUNC(test_string_show) {
   
 }
 
+PT_FUNC(test_string_intern) {
+  
+  var s0 = intern($S("Hello"));
+  var s1 = intern(new(String, $S("Hello")));
+  var s2 = intern($S("There"));
+  var s3 = new(Symbol, $S("Hello"));
+  
+  PT_ASSERT(type_of(s0) is Symbol);
+  PT_ASSERT(s0 is s1);
+  PT_ASSERT(s0 isnt s2);
+  PT_ASSERT(intern(s3) is s0);
+  PT_ASSERT(intern(s0) is s0);
+  PT_ASSERT(intern($(Symbol, "Hello", 0)) is s0);
+  PT_ASSERT(intern($(Symbol, "Bonjour", 0)) is intern($S("Bonjour")));
+  PT_ASSERT(eq(s0, s3));
+  PT_ASSERT(neq(s0, s2));
+  PT_ASSERT(eq(s0, $S("Hello")));
+  PT_ASSERT(eq($S("Hello"), s0));
+  PT_ASSERT(hash(s0) is hash($S("Hello")));
+  PT_ASSERT(hash($(Symbol, "Hello", 0)) is hash(s0));
+  PT_ASSERT(lt(intern($S("Apple")), intern($S("Banana"))));
+  PT_ASSERT(lt(intern($S("Apple")), $S("Banana")));
+  PT_ASSERT(gt(s2, s0) is gt($S("There"), $S("Hello")));
+  PT_ASSERT(len(s0) is 5);
+  
+  var e0 = NULL;
+  try { hash_seed(1); } catch (e in ValueError) { e0 = e; }
+  PT_ASSERT(e0 is ValueError);
+  PT_ASSERT(hash($S("Hello")) is hash(s0));
+  PT_ASSERT(strcmp(c_str(s3), "Hello") is 0);
+  
+  var t0 = new(Table, Symbol, Int);
+  var t1 = new(Tree, Symbol, Int);
+  var name = new(String);
+  
+  for (size_t i = 0; i < 200; i++) {
+    print_to(name, 0, "key%i", $I(i));
+    var k = intern(name);
+    set(t0, k, $I(i));
+    set(t1, k, $I(i));
+  }
+  
+  for (size_t i = 0; i < 200; i++) {
+    print_to(name, 0, "key%i", $I(i));
+    var k = intern(name);
+    PT_ASSERT(eq(get(t0, k), $I(i)));
+    PT_ASSERT(eq(get(t1, k), $I(i)));
+  }
+  
+  PT_ASSERT(len(t0) is 200);
+  PT_ASSERT(len(t1) is 200);
+  PT_ASSERT(not mem(t0, s0));
+  PT_ASSERT(not mem(t1, s0));
+  
+  del(s3);
+  del(t0);
+  del(t1);
+  
+}
+
 PT_SUITE(suite_string) {
   PT_REG(test_string_assign);
   PT_REG(test_string_c_str);
@@ -1708,6 +2161,7 @@ PT_SUITE(suite_string) {
   PT_REG(test_string_format);
   PT_REG(test_string_get);
   PT_REG(test_string_hash);
+  PT_REG(test_string_intern);
   PT_REG(test_string_len);
   PT_REG(test_string_new);
   PT_REG(test_string_resize);
@@ -1840,8 +2294,8 @@ PT_FUNC(test_table_hash) {
   set(t0, $S("There"), $I(5));
   
   PT_ASSERT(hash(t0) is (
-    hash($S("Hello")) ^ hash($I(2)) ^
-    hash($S("There")) ^ hash($I(5))));
+    hash_combine(hash($S("Hello")), hash($I(2))) +
+    hash_combine(hash($S("There")), hash($I(5)))));
   
   del(t0);
   
@@ -1994,6 +2448,797 @@ PT_FUNC(test_table_rehash) {
   del(t0);
 }
 
+PT_FUNC(test_table_try_get) {
+  
+  var t0 = new(Table, String, Int, $S("Hello"), $I(2));
+  PT_ASSERT(eq(try_get(t0, $S("Hello")), $I(2)));
+  PT_ASSERT(try_get(t0, $S("There")) is NULL);
+  PT_ASSERT(eq(get_or(t0, $S("There"), $I(5)), $I(5)));
+  del(t0);
+  
+  var t1 = new(Tree, String, Int, $S("Hello"), $I(2));
+  PT_ASSERT(eq(try_get(t1, $S("Hello")), $I(2)));
+  PT_ASSERT(try_get(t1, $S("There")) is NULL);
+  del(t1);
+  
+  var a0 = new(Array, Int, $I(1), $I(2));
+  var l0 = new(List, Int, $I(1), $I(2));
+  var u0 = tuple($I(1), $I(2));
+  var r0 = range($I(1), $I(3));
+  
+  PT_ASSERT(eq(try_get(a0, $I(-1)), $I(2)));
+  PT_ASSERT(eq(try_get(l0, $I(-1)), $I(2)));
+  PT_ASSERT(eq(try_get(u0, $I(-1)), $I(2)));
+  PT_ASSERT(eq(try_get(r0, $I(-1)), $I(2)));
+  PT_ASSERT(try_get(a0, $I(2)) is NULL);
+  PT_ASSERT(try_get(l0, $I(-3)) is NULL);
+  PT_ASSERT(try_get(u0, $I(2)) is NULL);
+  PT_ASSERT(try_get(r0, $I(2)) is NULL);
+  
+  del(a0);
+  del(l0);
+  
+}
+
+PT_FUNC(test_table_raw_keys) {
+  
+  var t0 = new(Table, String, Int, $S("Hello"), $I(1), $S("Hell"), $I(2));
+  var t1 = new(Tree, String, Int, $S("Hello"), $I(1), $S("Hell"), $I(2));
+  var t2 = new(FlatTable, String, Int, $S("Hello"), $I(1));
+  
+  PT_ASSERT(eq(get_cstr(t0, "Hello There", 5), $I(1)));
+  PT_ASSERT(eq(get_cstr(t0, "Hello There", 4), $I(2)));
+  PT_ASSERT(eq(get_cstr(t1, "Hello There", 5), $I(1)));
+  PT_ASSERT(eq(get_cstr(t1, "Hello There", 4), $I(2)));
+  PT_ASSERT(eq(get_cstr(t2, "Hello There", 5), $I(1)));
+  PT_ASSERT(not mem_cstr(t0, "Hel", 3));
+  PT_ASSERT(not mem_cstr(t1, "Hel", 3));
+  PT_ASSERT(not mem_cstr(t2, "Hell", 4));
+  PT_ASSERT(try_get_cstr(t0, "Hello There", 11) is NULL);
+  
+  set_cstr(t0, "Hello", 5, $I(3));
+  set_cstr(t1, "Hel", 3, $I(4));
+  PT_ASSERT(eq(get(t0, $S("Hello")), $I(3)));
+  PT_ASSERT(eq(get(t1, $S("Hel")), $I(4)));
+  PT_ASSERT(len(t0) is 2);
+  PT_ASSERT(len(t1) is 3);
+  
+  PT_ASSERT(not mem_cstr(t0, "Hell\0o", 6));
+  PT_ASSERT(not mem_cstr(t1, "Hell\0o", 6));
+  PT_ASSERT(not mem_cstr(t2, "Hello\0", 6));
+  
+  char long0[300];
+  memset(long0, 'x', sizeof(long0));
+  set_cstr(t0, long0, sizeof(long0), $I(5));
+  set_cstr(t1, long0, sizeof(long0), $I(5));
+  PT_ASSERT(eq(get_cstr(t0, long0, sizeof(long0)), $I(5)));
+  PT_ASSERT(eq(get_cstr(t1, long0, sizeof(long0)), $I(5)));
+  PT_ASSERT(not mem_cstr(t1, long0, sizeof(long0)-1));
+  PT_ASSERT(len(t0) is 3);
+  PT_ASSERT(len(t1) is 4);
+  
+  var f0 = freeze(t0);
+  var e0 = NULL;
+  try { set_cstr(f0, long0, sizeof(long0), $I(6)); } catch (e) { e0 = e; }
+  PT_ASSERT(e0 is ValueError);
+  e0 = NULL;
+  try { set_cstr(t0, "Hell\0o", 6, $I(6)); } catch (e) { e0 = e; }
+  PT_ASSERT(e0 is ValueError);
+  del(f0);
+  
+  var t3 = new(Table, Int, Int);
+  var t4 = new(Tree, Int, Int);
+  var t5 = new(Array, Int, $I(5), $I(6));
+  
+  for (int64_t i = -500; i < 500; i++) {
+    set_int(t3, i * 7, $I(i));
+    set_int(t4, i * 7, $I(i));
+  }
+  
+  for (int64_t i = -500; i < 500; i++) {
+    PT_ASSERT(eq(get_int(t3, i * 7), $I(i)));
+    PT_ASSERT(eq(get_int(t4, i * 7), $I(i)));
+    PT_ASSERT(not mem_int(t3, i * 7 + 1));
+    PT_ASSERT(not mem_int(t4, i * 7 + 1));
+  }
+  
+  PT_ASSERT(mem_int(t3, 0));
+  PT_ASSERT(not mem_int(t3, 1));
+  PT_ASSERT(eq(get_int(t5, 1), $I(6)));
+  PT_ASSERT(eq(get_cstr(t0, "Hell", 4), get_cstr(t1, "Hell", 4)));
+  
+  char key[16];
+  for (int i = 0; i < 200; i++) {
+    int n = sprintf(key, "k%i", i);
+    set_cstr(t0, key, n, $I(i));
+    set_cstr(t1, key, n, $I(i));
+  }
+  
+  PT_ASSERT(eq(get(t0, $S("k150")), $I(150)));
+  PT_ASSERT(eq(get(t1, $S("k150")), $I(150)));
+  PT_ASSERT(len(t0) is 203);
+  PT_ASSERT(len(t1) is 204);
+  
+  del(t0);
+  del(t1);
+  del(t2);
+  del(t3);
+  del(t4);
+  del(t5);
+  
+}
+
+PT_FUNC(test_table_get_many) {
+  
+  var t0 = new(Table, Int, Int);
+  var t1 = new(Tree, Int, Int);
+  var keys = new(Array, Int);
+  
+  for (int64_t i = 0; i < 1000; i++) {
+    set(t0, $I(i * 3), $I(i));
+    set(t1, $I(i * 3), $I(i));
+    push(keys, $I(i * 3));
+  }
+  
+  var v0 = new(Array, Int);
+  var v1 = new(Array, Int);
+  get_many(t0, keys, v0);
+  get_many(t1, keys, v1);
+  
+  PT_ASSERT(len(v0) is 1000);
+  PT_ASSERT(eq(v0, v1));
+  PT_ASSERT(eq(get(v0, $I(999)), $I(999)));
+  
+  var m0 = new(Array, Int);
+  var m1 = new(Array, Int);
+  mem_many(t0, range($I(0), $I(60)), m0);
+  mem_many(t0, tuple($I(2), $I(3), $I(4)), m1);
+  
+  PT_ASSERT(len(m0) is 60);
+  PT_ASSERT(eq(get(m0, $I(0)), $I(1)));
+  PT_ASSERT(eq(get(m0, $I(1)), $I(0)));
+  PT_ASSERT(eq(get(m0, $I(57)), $I(1)));
+  PT_ASSERT(eq(m1, tuple($I(0), $I(1), $I(0))));
+  
+  var e = NULL;
+  try {
+    get_many(t0, tuple($I(3), $I(4)), v0);
+  } catch (err in KeyError) {
+    e = err;
+  }
+  PT_ASSERT(e is KeyError);
+  
+  del(t0);
+  del(t1);
+  del(keys);
+  del(v0);
+  del(v1);
+  del(m0);
+  del(m1);
+  
+}
+
+PT_FUNC(test_table_from) {
+  
+  var keys = new(Array, Int);
+  var vals = new(Array, String);
+  
+  for (int64_t i = 0; i < 2000; i++) {
+    push(keys, $I(i % 1500));
+    push(vals, i < 1500 ? $S("first") : $S("last"));
+  }
+  
+  var t0 = table_from(keys, vals);
+  
+  PT_ASSERT(len(t0) is 1500);
+  PT_ASSERT(key_type(t0) is Int);
+  PT_ASSERT(val_type(t0) is String);
+  PT_ASSERT(eq(get(t0, $I(0)), $S("last")));
+  PT_ASSERT(eq(get(t0, $I(499)), $S("last")));
+  PT_ASSERT(eq(get(t0, $I(500)), $S("first")));
+  
+  var t1 = table_from(range($I(10)), range($I(10), $I(20)));
+  PT_ASSERT(len(t1) is 10);
+  PT_ASSERT(eq(get(t1, $I(3)), $I(13)));
+  
+  var t2 = new(Table, Int, String, $I(-1), $S("neg"), $I(0), $S("zero"));
+  concat(t2, t0);
+  concat(t2, t2);
+  
+  PT_ASSERT(len(t2) is 1501);
+  PT_ASSERT(eq(get(t2, $I(-1)), $S("neg")));
+  PT_ASSERT(eq(get(t2, $I(0)), $S("last")));
+  PT_ASSERT(eq(get(t2, $I(1000)), $S("first")));
+  
+  var t3 = new(Table, Int, String);
+  assign(t3, t0);
+  PT_ASSERT(eq(t3, t0));
+  
+  del(keys);
+  del(vals);
+  del(t0);
+  del(t1);
+  del(t2);
+  del(t3);
+  
+}
+
+PT_FUNC(test_table_reserve) {
+  
+  var t0 = new(Table, Int, Int);
+  reserve(t0, 1000);
+  load_factors(t0, 0.0, 0.5);
+  
+  for (int64_t i = 0; i < 1000; i++) { set(t0, $I(i), $I(i * 2)); }
+  for (int64_t i = 0; i < 999; i++) { rem(t0, $I(i)); }
+  for (int64_t i = 0; i < 100; i++) {
+    set(t0, $I(-1), $I(i));
+    rem(t0, $I(-1));
+  }
+  
+  PT_ASSERT(len(t0) is 1);
+  PT_ASSERT(eq(get(t0, $I(999)), $I(1998)));
+  
+  shrink_to_fit(t0);
+  PT_ASSERT(eq(get(t0, $I(999)), $I(1998)));
+  
+  load_factors(t0, 0.1, 0.8);
+  for (int64_t i = 0; i < 500; i++) { set(t0, $I(i), $I(i)); }
+  PT_ASSERT(len(t0) is 501);
+  PT_ASSERT(eq(get(t0, $I(250)), $I(250)));
+  
+  rem(t0, $I(999));
+  shrink_to_fit(t0);
+  for (int64_t i = 0; i < 500; i++) { rem(t0, $I(i)); }
+  shrink_to_fit(t0);
+  PT_ASSERT(len(t0) is 0);
+  set(t0, $I(1), $I(2));
+  PT_ASSERT(eq(get(t0, $I(1)), $I(2)));
+  
+  var e = NULL;
+  try { load_factors(t0, 0.5, 0.9); } catch (err in ValueError) { e = err; }
+  PT_ASSERT(e is ValueError);
+  
+  del(t0);
+  
+}
+
+static var table_set_alias_find(var t, var k) {
+  foreach (key in t) { if (eq(key, k)) { return key; } }
+  return NULL;
+}
+
+PT_FUNC(test_table_set_alias) {
+  
+  var t = new(Table, String, String);
+  var c = new(Table, String, String);
+  var k = new(String);
+  var v = new(String);
+  var n = new(String);
+  
+  for (size_t i = 0; i < 64; i++) {
+    print_to(k, 0, "key%i", $I(i));
+    print_to(v, 0, "val%i", $I(i));
+    set(t, k, v);
+  }
+  
+  bool intact = true;
+  
+  for (size_t i = 0; i < 64; i++) {
+    
+    print_to(k, 0, "key%i", $I(i));
+    print_to(v, 0, "val%i", $I(i));
+    
+    for (size_t j = 0; j < 16; j++) {
+      
+      assign(c, t);
+      
+      /* Insert a value and then a key which live in the same table */
+      print_to(n, 0, "new%i", $I(j));
+      set(c, n, get(c, k));
+      intact = intact and eq(get(c, n), v);
+      
+      print_to(n, 0, "old%i", $I(j));
+      set(c, n, table_set_alias_find(c, k));
+      intact = intact and eq(get(c, n), k);
+      
+      foreach (key in t) {
+        intact = intact and eq(get(c, key), get(t, key));
+      }
+    }
+  }
+  
+  PT_ASSERT(intact);
+  
+  del(t);
+  del(c);
+  del(k);
+  del(v);
+  del(n);
+  
+}
+
+PT_FUNC(test_table_get_or_insert) {
+  
+  var words = tuple(
+    $S("a"), $S("b"), $S("a"), $S("c"), $S("a"), $S("b"));
+  
+  var t0 = new(Table, String, Int);
+  var t1 = new(Tree, String, Int);
+  
+  foreach (word in words) {
+    struct Int* c0 = get_or_insert(t0, word, $I(0));
+    struct Int* c1 = get_or_insert(t1, word, $I(0));
+    c0->val++;
+    c1->val++;
+  }
+  
+  PT_ASSERT(len(t0) is 3);
+  PT_ASSERT(len(t1) is 3);
+  PT_ASSERT(eq(get(t0, $S("a")), $I(3)));
+  PT_ASSERT(eq(get(t0, $S("b")), $I(2)));
+  PT_ASSERT(eq(get(t1, $S("a")), $I(3)));
+  PT_ASSERT(eq(get(t1, $S("c")), $I(1)));
+  
+  var t2 = new(Table, Int, Int);
+  for (size_t i = 0; i < 1000; i++) {
+    struct Int* v = get_or_insert(t2, $I(i), $I(i));
+    PT_ASSERT(v->val is (int64_t)i);
+  }
+  PT_ASSERT(len(t2) is 1000);
+  PT_ASSERT(eq(get(t2, $I(500)), $I(500)));
+  
+  set(t2, $I(1000), get(t2, $I(999)));
+  PT_ASSERT(eq(get(t2, $I(1000)), $I(999)));
+  
+  del(t0);
+  del(t1);
+  del(t2);
+  
+}
+
+PT_FUNC(test_table_flat) {
+  
+  var t0 = new(FlatTable, Int, Int);
+  
+  for (size_t i = 0; i < 5000; i++) {
+    set(t0, $I(i * 16), $I(i));
+  }
+  
+  for (size_t i = 0; i < 5000; i += 2) {
+    rem(t0, $I(i * 16));
+  }
+  
+  PT_ASSERT(len(t0) is 2500);
+  PT_ASSERT(not mem(t0, $I(0)));
+  PT_ASSERT(mem(t0, $I(16)));
+  PT_ASSERT(try_get(t0, $I(32)) is NULL);
+  PT_ASSERT(eq(get(t0, $I(4999 * 16)), $I(4999)));
+  
+  size_t count = 0;
+  foreach (key in t0) {
+    PT_ASSERT(c_int(get(t0, key)) % 2 is 1);
+    count++;
+  }
+  PT_ASSERT(count is 2500);
+  
+  for (size_t i = 0; i < 5000; i++) {
+    struct Int* v = get_or_insert(t0, $I(i * 16), $I(-1));
+    v->val++;
+  }
+  
+  PT_ASSERT(len(t0) is 5000);
+  PT_ASSERT(eq(get(t0, $I(0)), $I(0)));
+  PT_ASSERT(eq(get(t0, $I(16)), $I(2)));
+  
+  var t1 = new(FlatTable, String, Int,
+    $S("Hello"), $I(2), $S("There"), $I(5));
+  var t2 = new(Table, String, Int,
+    $S("Hello"), $I(2), $S("There"), $I(5));
+  var t3 = new(FlatTable, String, Int);
+  assign(t3, t2);
+  
+  PT_ASSERT(eq(get(t1, $S("There")), $I(5)));
+  PT_ASSERT(eq(get(t3, $S("Hello")), $I(2)));
+  PT_ASSERT(len(t3) is 2);
+  
+  resize(t1, 100);
+  PT_ASSERT(eq(get(t1, $S("Hello")), $I(2)));
+  resize(t1, 0);
+  PT_ASSERT(len(t1) is 0);
+  PT_ASSERT(not mem(t1, $S("Hello")));
+  set(t1, $S("Hello"), $I(3));
+  PT_ASSERT(eq(get(t1, $S("Hello")), $I(3)));
+  
+  var t4 = new(FlatTable, Int, Int);
+  for (int64_t i = 0; i < 100; i++) { set(t4, $I(i), $I(i)); }
+  for (int64_t i = 100; i < 10000; i++) {
+    set(t4, $I(i), $I(i));
+    rem(t4, $I(i % 100));
+    set(t4, $I(i % 100), $I(i));
+    rem(t4, $I(i));
+  }
+  
+  PT_ASSERT(len(t4) is 100);
+  for (int64_t i = 0; i < 100; i++) { PT_ASSERT(mem(t4, $I(i))); }
+  PT_ASSERT(eq(get(t4, $I(0)), $I(9900)));
+  
+  del(t0);
+  del(t1);
+  del(t2);
+  del(t3);
+  del(t4);
+  
+}
+
+PT_FUNC(test_table_ordered) {
+  
+  var t0 = new(OrderedTable, Int, Int);
+  
+  for (size_t i = 0; i < 5000; i++) {
+    set(t0, $I(4999 - i), $I(i));
+  }
+  
+  for (size_t i = 0; i < 5000; i += 2) {
+    rem(t0, $I(i));
+  }
+  
+  PT_ASSERT(len(t0) is 2500);
+  PT_ASSERT(not mem(t0, $I(0)));
+  PT_ASSERT(mem(t0, $I(1)));
+  PT_ASSERT(try_get(t0, $I(2)) is NULL);
+  PT_ASSERT(eq(get(t0, $I(4999)), $I(0)));
+  
+  int64_t prev = 5000;
+  foreach (key in t0) {
+    PT_ASSERT(c_int(key) < prev);
+    PT_ASSERT(c_int(key) % 2 is 1);
+    prev = c_int(key);
+  }
+  PT_ASSERT(prev is 1);
+  PT_ASSERT(eq(iter_last(t0), $I(1)));
+  
+  set(t0, $I(4999), $I(7));
+  set(t0, $I(0), $I(8));
+  PT_ASSERT(eq(iter_init(t0), $I(4999)));
+  PT_ASSERT(eq(iter_last(t0), $I(0)));
+  
+  struct Int* v = get_or_insert(t0, $I(2), $I(-1));
+  v->val++;
+  PT_ASSERT(eq(get(t0, $I(2)), $I(0)));
+  PT_ASSERT(eq(iter_last(t0), $I(2)));
+  
+  var t1 = new(OrderedTable, String, Int,
+    $S("Hello"), $I(2), $S("There"), $I(5));
+  var t2 = new(OrderedTable, String, Int,
+    $S("There"), $I(5), $S("Hello"), $I(2));
+  var t3 = new(OrderedTable, String, Int);
+  assign(t3, t1);
+  
+  PT_ASSERT(eq(iter_init(t1), $S("Hello")));
+  PT_ASSERT(eq(iter_init(t2), $S("There")));
+  PT_ASSERT(eq(t1, t3));
+  PT_ASSERT(neq(t1, t2));
+  PT_ASSERT(hash(t1) is hash(t2));
+  
+  resize(t1, 100);
+  PT_ASSERT(eq(get(t1, $S("Hello")), $I(2)));
+  resize(t1, 0);
+  PT_ASSERT(len(t1) is 0);
+  PT_ASSERT(iter_init(t1) is Terminal);
+  set(t1, $S("Hello"), $I(3));
+  PT_ASSERT(eq(get(t1, $S("Hello")), $I(3)));
+  
+  del(t0);
+  del(t1);
+  del(t2);
+  del(t3);
+  
+}
+
+static volatile bool TableConcurrentIntact = true;
+
+static var test_table_concurrent_fill(var args) {
+  var table = get(args, $I(0));
+  int64_t base = c_int(get(args, $I(1)));
+  for (int64_t i = base; i < base + 1000; i++) {
+    set(table, $I(i), $I(i * 2));
+    if (not eq(get(table, $I(i)), $I(i * 2))) {
+      TableConcurrentIntact = false;
+    }
+  }
+  return NULL;
+}
+
+static var test_table_concurrent_inc(var args) {
+  var val = get(args, $I(0));
+  assign(val, $I(c_int(val) + 1));
+  return NULL;
+}
+
+static var test_table_concurrent_toggle(var args) {
+  return get(args, $I(1)) is NULL ? new(Int, $I(1)) : NULL;
+}
+
+static var test_table_concurrent_count(var args) {
+  var table = get(args, $I(0));
+  var inc = $(Function, test_table_concurrent_inc);
+  for (int64_t i = 0; i < 1000; i++) {
+    concurrent_update(table, $I(i % 8), $I(0), inc);
+  }
+  return NULL;
+}
+
+static var test_table_concurrent_overwrite(var args) {
+  var table = get(args, $I(0));
+  var short_val = $S("short");
+  var long_val = $S("a value long enough to be reallocated when set");
+  for (int64_t i = 0; i < 20000; i++) {
+    set(table, $I(i % 16), i % 2 ? long_val : short_val);
+  }
+  return NULL;
+}
+
+static var test_table_concurrent_read(var args) {
+  var table = get(args, $I(0));
+  for (int64_t i = 0; i < 20000; i++) {
+    var val = get(table, $I(i % 16));
+    if (not eq(val, $S("short")) and len(val) isnt 46) {
+      TableConcurrentIntact = false;
+    }
+  }
+  return NULL;
+}
+
+PT_FUNC(test_table_concurrent) {
+  
+  var t0 = new(ConcurrentTable, String, Int,
+    $S("Hello"), $I(2), $S("There"), $I(5));
+  
+  PT_ASSERT(len(t0) is 2);
+  PT_ASSERT(mem(t0, $S("Hello")));
+  PT_ASSERT(not mem(t0, $S("Bonjour")));
+  PT_ASSERT(try_get(t0, $S("Bonjour")) is NULL);
+  PT_ASSERT(eq(get(t0, $S("There")), $I(5)));
+  PT_ASSERT(key_type(t0) is String);
+  PT_ASSERT(val_type(t0) is Int);
+  
+  var inc = $(Function, test_table_concurrent_inc);
+  concurrent_update(t0, $S("Bonjour"), $I(1), inc);
+  PT_ASSERT(eq(get(t0, $S("Bonjour")), $I(2)));
+  concurrent_update(t0, $S("Bonjour"), $I(1), inc);
+  PT_ASSERT(eq(get(t0, $S("Bonjour")), $I(3)));
+  
+  var toggle = $(Function, test_table_concurrent_toggle);
+  concurrent_compute(t0, $S("Salut"), toggle);
+  PT_ASSERT(eq(get(t0, $S("Salut")), $I(1)));
+  concurrent_compute(t0, $S("Salut"), toggle);
+  PT_ASSERT(not mem(t0, $S("Salut")));
+  
+  /* Values are returned as copies unchanged by later writes */
+  var v2 = get(t0, $S("There"));
+  set(t0, $S("There"), $I(6));
+  PT_ASSERT(eq(v2, $I(5)));
+  PT_ASSERT(eq(get(t0, $S("There")), $I(6)));
+  set(t0, $S("There"), $I(5));
+  
+  rem(t0, $S("Hello"));
+  PT_ASSERT(not mem(t0, $S("Hello")));
+  PT_ASSERT(len(t0) is 2);
+  
+  size_t n = 0;
+  foreach (key in t0) {
+    PT_ASSERT(mem(t0, key));
+    n++;
+  }
+  PT_ASSERT(n is 2);
+  
+  var t1 = new(Table, String, Int);
+  assign(t1, t0);
+  PT_ASSERT(len(t1) is 2);
+  PT_ASSERT(eq(get(t1, $S("There")), $I(5)));
+  
+  resize(t0, 0);
+  PT_ASSERT(len(t0) is 0);
+  PT_ASSERT(iter_init(t0) is Terminal);
+  
+  var t2 = new(ConcurrentTable, Int, Int);
+  var func = $(Function, test_table_concurrent_fill);
+  var bases[4] = { $I(0), $I(1000), $I(2000), $I(3000) };
+  var threads[4];
+  
+  for (size_t i = 0; i < 4; i++) {
+    threads[i] = new(Thread, func);
+    call(threads[i], t2, bases[i]);
+  }
+  
+  for (size_t i = 0; i < 4; i++) {
+    join(threads[i]);
+    del(threads[i]);
+  }
+  
+  PT_ASSERT(TableConcurrentIntact);
+  PT_ASSERT(len(t2) is 4000);
+  for (int64_t i = 0; i < 4000; i++) {
+    PT_ASSERT(eq(get(t2, $I(i)), $I(i * 2)));
+  }
+  
+  var t3 = new(ConcurrentTable, Int, String);
+  for (int64_t i = 0; i < 16; i++) { set(t3, $I(i), $S("short")); }
+  
+  threads[0] = new(Thread, $(Function, test_table_concurrent_overwrite));
+  threads[1] = new(Thread, $(Function, test_table_concurrent_read));
+  threads[2] = new(Thread, $(Function, test_table_concurrent_read));
+  
+  for (size_t i = 0; i < 3; i++) { call(threads[i], t3); }
+  for (size_t i = 0; i < 3; i++) {
+    join(threads[i]);
+    del(threads[i]);
+  }
+  
+  PT_ASSERT(TableConcurrentIntact);
+  PT_ASSERT(len(t3) is 16);
+  
+  var t4 = new(ConcurrentTable, Int, Int);
+  for (size_t i = 0; i < 4; i++) {
+    threads[i] = new(Thread, $(Function, test_table_concurrent_count));
+    call(threads[i], t4);
+  }
+  
+  for (size_t i = 0; i < 4; i++) {
+    join(threads[i]);
+    del(threads[i]);
+  }
+  
+  for (int64_t i = 0; i < 8; i++) {
+    PT_ASSERT(eq(get(t4, $I(i)), $I(500)));
+  }
+  
+  del(t0);
+  del(t1);
+  del(t2);
+  del(t3);
+  del(t4);
+  
+}
+
+struct HashClash {
+  int64_t val;
+};
+
+static int HashClash_Cmp(var self, var obj) {
+  struct HashClash* a = self;
+  struct HashClash* b = obj;
+  return (int)(a->val - b->val);
+}
+
+static uint64_t HashClash_Hash(var self) {
+  return 42;
+}
+
+static var HashClash = Cello(HashClash,
+  Instance(Cmp,  HashClash_Cmp),
+  Instance(Hash, HashClash_Hash));
+
+PT_FUNC(test_table_frozen) {
+  
+  var t0 = new(Table, Int, Int);
+  for (size_t i = 0; i < 5000; i++) {
+    set(t0, $I(i * 7), $I(i));
+  }
+  
+  var f0 = freeze(t0);
+  
+  PT_ASSERT(type_of(f0) is FrozenTable);
+  PT_ASSERT(len(f0) is 5000);
+  PT_ASSERT(key_type(f0) is Int);
+  PT_ASSERT(val_type(f0) is Int);
+  
+  for (size_t i = 0; i < 5000; i++) {
+    PT_ASSERT(eq(get(f0, $I(i * 7)), $I(i)));
+    PT_ASSERT(not mem(f0, $I(i * 7 + 1)));
+  }
+  PT_ASSERT(try_get(f0, $I(-1)) is NULL);
+  
+  size_t n = 0;
+  foreach (key in f0) {
+    PT_ASSERT(c_int(key) % 7 is 0);
+    n++;
+  }
+  PT_ASSERT(n is 5000);
+  
+  PT_ASSERT(eq(f0, freeze(t0)));
+  PT_ASSERT(hash(f0) is hash(t0));
+  PT_ASSERT(eq(get_int(f0, 70), $I(10)));
+  PT_ASSERT(not mem_int(f0, 71));
+  
+  PT_ASSERT(len(freeze(new(Table, Int, Int))) is 0);
+  
+  var f1 = new(FrozenTable, String, Int,
+    $S("Hello"), $I(2), $S("There"), $I(5), $S("Hello"), $I(3));
+  
+  PT_ASSERT(len(f1) is 2);
+  PT_ASSERT(eq(get(f1, $S("Hello")), $I(3)));
+  PT_ASSERT(eq(get(f1, $S("There")), $I(5)));
+  PT_ASSERT(not mem(f1, $S("Bonjour")));
+  PT_ASSERT(eq(get_cstr(f1, "There!", 5), $I(5)));
+  PT_ASSERT(not mem_cstr(f1, "There!", 6));
+  
+  var f4 = new(FrozenTable, HashClash, Int,
+    $(HashClash, 1), $I(1), $(HashClash, 2), $I(2),
+    $(HashClash, 3), $I(3), $(HashClash, 4), $I(4));
+  
+  PT_ASSERT(len(f4) is 4);
+  PT_ASSERT(eq(get(f4, $(HashClash, 1)), $I(1)));
+  PT_ASSERT(eq(get(f4, $(HashClash, 3)), $I(3)));
+  PT_ASSERT(eq(get(f4, $(HashClash, 4)), $I(4)));
+  PT_ASSERT(not mem(f4, $(HashClash, 5)));
+  
+  var f2 = copy(f1);
+  PT_ASSERT(eq(f1, f2));
+  
+  bool reached0 = false, reached1 = false;
+  bool reached2 = false, reached3 = false;
+  bool reached4 = false, reached5 = false;
+  
+  try {
+    set(f1, $S("Bonjour"), $I(1));
+  } catch (e in ValueError) {
+    reached0 = true;
+  }
+  
+  try {
+    rem(f1, $S("Hello"));
+  } catch (e in ValueError) {
+    reached1 = true;
+  }
+  
+  try {
+    set_cstr(f1, "Hello", 5, $I(99));
+  } catch (e in ValueError) {
+    reached2 = true;
+  }
+  
+  try {
+    set_int(f0, 7, $I(99));
+  } catch (e in ValueError) {
+    reached3 = true;
+  }
+  
+  /* Keys of a Tuple are cast to Ref, which fails part way through a build */
+  var f3 = new(FrozenTable, Int, Int);
+  try {
+    assign(f3, tuple($I(0), $I(1)));
+  } catch (e in ValueError) {
+    reached4 = true;
+  }
+  
+  try {
+    new(FrozenTable, Int, Int, $I(1), $I(2), $S("Hello"), $I(3));
+  } catch (e in ValueError) {
+    reached5 = true;
+  }
+  
+  PT_ASSERT(reached0);
+  PT_ASSERT(reached1);
+  PT_ASSERT(reached2);
+  PT_ASSERT(reached3);
+  PT_ASSERT(reached4);
+  PT_ASSERT(reached5);
+  PT_ASSERT(len(f3) is 0);
+  PT_ASSERT(len(f1) is 2);
+  PT_ASSERT(eq(get(f1, $S("Hello")), $I(3)));
+  PT_ASSERT(eq(get(f0, $I(7)), $I(1)));
+  
+  del(t0);
+  del(f0);
+  del(f1);
+  del(f2);
+  del(f3);
+  del(f4);
+  
+}
+
 PT_SUITE(suite_table) {
   PT_REG(test_table_assign);
   PT_REG(test_table_cmp);
@@ -2005,6 +3250,17 @@ PT_SUITE(suite_table) {
   PT_REG(test_table_resize);
   PT_REG(test_table_show);
   PT_REG(test_table_rehash);
+  PT_REG(test_table_try_get);
+  PT_REG(test_table_get_or_insert);
+  PT_REG(test_table_set_alias);
+  PT_REG(test_table_raw_keys);
+  PT_REG(test_table_get_many);
+  PT_REG(test_table_from);
+  PT_REG(test_table_reserve);
+  PT_REG(test_table_flat);
+  PT_REG(test_table_ordered);
+  PT_REG(test_table_concurrent);
+  PT_REG(test_table_frozen);
 }
 
 /* Thread */
@@ -2278,8 +3534,8 @@ PT_FUNC(test_tree_hash) {
   set(m0, $S("There"), $I(5));
   
   PT_ASSERT(hash(m0) is (
-    hash($S("Hello")) ^ hash($I(2)) ^
-    hash($S("There")) ^ hash($I(5))));
+    hash_combine(hash($S("Hello")), hash($I(2))) +
+    hash_combine(hash($S("There")), hash($I(5)))));
   
   del(m0);
   
@@ -2486,9 +3742,35 @@ PT_FUNC(test_tuple_get) {
 PT_FUNC(test_tuple_hash) {
   
   var x = tuple($S("Hello"), $S("World"), $S("!"));
+  var y = new(Tuple, $I(1), $I(2));
+  
+  uint64_t h = hash_combine(hash_combine(hash_combine(0,
+    hash($S("Hello"))), hash($S("World"))), hash($S("!")));
   
-  PT_ASSERT(hash(x) is (
-    hash($S("Hello")) ^ hash($S("World")) ^ hash($S("!"))));
+  PT_ASSERT(hash(x) is h);
+  PT_ASSERT(hash(tuple($I(1), $I(1))) isnt 0);
+  PT_ASSERT(hash(tuple($I(1), $I(2))) isnt hash(tuple($I(2), $I(1))));
+  
+  hash_cache(x);
+  PT_ASSERT(hash(x) is h);
+  set(x, $I(2), $S("?"));
+  PT_ASSERT(hash(x) isnt h);
+  
+  uint64_t h0 = hash(y);
+  hash_cache(y);
+  push(y, $I(3));
+  PT_ASSERT(hash(y) isnt h0);
+  pop(y);
+  PT_ASSERT(hash(y) is h0);
+  
+  var t = new(Table, Tuple, Int);
+  hash_cache(y);
+  set(t, y, $I(5));
+  PT_ASSERT(eq(get(t, y), $I(5)));
+  PT_ASSERT(eq(get(t, tuple($I(1), $I(2))), $I(5)));
+  
+  del(t);
+  del(y);
   
 }
 
@@ -2750,9 +4032,81 @@ PT_FUNC(test_zip_new) {
   
 }
 
+PT_FUNC(test_zip_items) {
+  
+  var t = new(Table, String, Int);
+  var m = new(Tree, Int, String);
+  var o = new(OrderedTable, String, Int);
+  var l = new(FlatTable, String, Int);
+  var f = new(FrozenTable, String, Int,
+    $S("Apple"), $I(12), $S("Banana"), $I(6), $S("Pear"), $I(55));
+  
+  set(t, $S("Apple"),  $I(12));
+  set(t, $S("Banana"), $I( 6));
+  set(t, $S("Pear"),   $I(55));
+  set(m, $I(3), $S("Three"));
+  set(m, $I(1), $S("One"));
+  set(m, $I(2), $S("Two"));
+  assign(o, t);
+  assign(l, t);
+  
+  int64_t total = 0;
+  foreach (pair in items(t)) {
+    PT_ASSERT(get(pair, $I(1)) is get(t, get(pair, $I(0))));
+    total += c_int(get(pair, $I(1)));
+  }
+  PT_ASSERT(total is 73);
+  
+  var key = iter_init(m);
+  foreach (pair in items(m)) {
+    PT_ASSERT(get(pair, $I(0)) is key);
+    PT_ASSERT(get(pair, $I(1)) is get(m, key));
+    key = iter_next(m, key);
+  }
+  PT_ASSERT(key is Terminal);
+  
+  var last = iter_last(items(m));
+  PT_ASSERT(get(last, $I(0)) is iter_last(m));
+  
+  foreach (pair in items(o)) {
+    PT_ASSERT(get(pair, $I(1)) is get(o, get(pair, $I(0))));
+  }
+  
+  foreach (pair in items(l)) {
+    PT_ASSERT(get(pair, $I(1)) is get(l, get(pair, $I(0))));
+  }
+  
+  foreach (pair in items(f)) {
+    PT_ASSERT(get(pair, $I(1)) is get(f, get(pair, $I(0))));
+  }
+  
+  var o2 = copy(o);
+  var l2 = copy(l);
+  PT_ASSERT(eq(o, o2));
+  PT_ASSERT(eq(l, l2));
+  set(o2, $S("Pear"), $I(56));
+  set(l2, $S("Pear"), $I(56));
+  PT_ASSERT(neq(o, o2));
+  PT_ASSERT(neq(l, l2));
+  
+  PT_ASSERT(len(items(t)) is 3);
+  PT_ASSERT(iter_type(items(m)) is Tuple);
+  PT_ASSERT(iter_val(m, iter_init(m)) is get(m, iter_init(m)));
+  
+  del(t);
+  del(m);
+  del(o);
+  del(l);
+  del(f);
+  del(o2);
+  del(l2);
+  
+}
+
 PT_SUITE(suite_zip) {
   PT_REG(test_zip_get);
   PT_REG(test_zip_iter);
+  PT_REG(test_zip_items);
   PT_REG(test_zip_len);
   PT_REG(test_zip_new);
 }
@@ -2870,12 +4224,44 @@ PT_FUNC(test_exception_catch_outer) {
   
 }
 
+static void exception_missing(var table, int64_t key) {
+  get(table, $I(key));
+}
+
+static void exception_clobber(void) {
+  volatile char buffer[1024];
+  memset((char*)buffer, 0xFF, sizeof(buffer));
+}
+
+PT_FUNC(test_exception_message) {
+  
+  var table = new(Table, Int, Int);
+  var name = new(String, $S("Heap"));
+  
+  try {
+    exception_missing(table, 42);
+  } catch (e in KeyError) {
+    exception_clobber();
+    PT_ASSERT(exception_object() is KeyError);
+    PT_ASSERT(strstr(c_str(exception_message()), "42"));
+  }
+  
+  try {
+    throw(ValueError, "%s %i %s", name, $I(7), $S("Stack"));
+  } catch (e in ValueError) {
+    exception_clobber();
+    PT_ASSERT_STR_EQ(c_str(exception_message()), "Heap 7 Stack");
+  }
+  
+}
+
 PT_SUITE(suite_exception) {
   
   PT_REG(test_exception_throw);
   PT_REG(test_exception_catch);
   PT_REG(test_exception_catch_all);
   PT_REG(test_exception_catch_outer);
+  PT_REG(test_exception_message);
 
 }
 
@@ -2887,6 +4273,9 @@ int main(int argc, char** argv) {
   pt_add_suite(suite_float);
   pt_add_suite(suite_filter);
   pt_add_suite(suite_function);
+#if defined(CELLO_WINDOWS) || defined(CELLO_UNIX)
+  pt_add_suite(suite_gc);
+#endif
   pt_add_suite(suite_int);
   pt_add_suite(suite_list);
   pt_add_suite(suite_map);